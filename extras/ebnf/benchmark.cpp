@@ -0,0 +1,102 @@
+/*
+ * EBNF benchmark.
+ *
+ * Usage:
+ *  benchmark file...   parses each file
+ *  benchmark -g rules  parses a generated grammar with the given number of rules
+ *
+ * For each input, it reports the parse time, the throughput and the number of matches.
+ * Build: g++ -std=c++17 -O2 -I../../include -I.. benchmark.cpp ebnf.cpp -o benchmark
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "ebnf.hpp"
+
+
+using namespace parserlib::ebnf;
+
+
+//generates a grammar with the given number of rules; rules refer to other rules,
+//and use every kind of term, postfix operator, exception and comment
+static std::string generate(size_t ruleCount) {
+    std::string result;
+    const auto name = [](size_t index) { return "rule_" + std::to_string(index); };
+    for (size_t index = 0; index < ruleCount; ++index) {
+        const std::string a = name((index * 7 + 1) % ruleCount);
+        const std::string b = name((index * 13 + 2) % ruleCount);
+        const std::string c = name((index * 31 + 3) % ruleCount);
+        result += "(* rule " + std::to_string(index) + ", generated *)\n";
+        result += name(index) + " = " + a + " , 'x" + std::to_string(index) + "' , [ " + b + " | \"y\" ]";
+        result += "\n    | { " + c + " , ( " + a + " | " + b + " )* } , " + c + "?";
+        result += "\n    | " + a + "+ , ( " + b + " - 'z' ) , [ [ ( " + c + " ) ] ] ;\n\n";
+    }
+    return result;
+}
+
+
+//counts the matches of a tree
+static size_t countMatches(const Match& match) {
+    size_t result = 1;
+    for (const Match& child : match.children()) {
+        result += countMatches(child);
+    }
+    return result;
+}
+
+
+//parses the input, and reports the results
+static bool run(const std::string& name, const std::string& input) {
+    using Clock = std::chrono::steady_clock;
+    const double megabytes = static_cast<double>(input.size()) / (1024.0 * 1024.0);
+
+    EBNFParseContext pc(input);
+    const auto start = Clock::now();
+    const bool ok = parse(pc);
+    const auto parsed = Clock::now();
+    if (!ok) {
+        const auto pos = lineAndColumn(input, pc.errors().empty() ? pc.sourcePosition() : pc.errors().back().position());
+        std::cout << name << ": parsing failed at line " << pos.first << ", column " << pos.second << "\n";
+        return false;
+    }
+
+    size_t matchCount = 0;
+    for (const Match& match : pc.matches()) {
+        matchCount += countMatches(match);
+    }
+
+    const double seconds = std::chrono::duration<double>(parsed - start).count();
+    std::cout << name << ": " << megabytes << " MB, " << pc.matches().size() << " rules, " << matchCount << " matches, ";
+    std::cout << seconds * 1000.0 << " ms, " << megabytes / seconds << " MB/s\n";
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "usage: benchmark file... | benchmark -g rules\n";
+        return 1;
+    }
+
+    bool ok = true;
+
+    if (std::string(argv[1]) == "-g" && argc > 2) {
+        const size_t ruleCount = static_cast<size_t>(std::atol(argv[2]));
+        ok = run("generated, " + std::to_string(ruleCount) + " rules", generate(ruleCount));
+    }
+    else {
+        for (int index = 1; index < argc; ++index) {
+            std::ifstream file(argv[index], std::ios::binary);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            ok = file && run(argv[index], stream.str()) && ok;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -1,9 +1,17 @@
 /*
  * EBNF grammar, taken from
  * https://en.wikipedia.org/wiki/Extended_Backus%E2%80%93Naur_form
+ *
+ * It is written so as that grammars are parsed in linear time:
+ *  - whitespace and comments are skipped by a skipper, instead of by a loop over characters;
+ *  - identifiers and terminals are scanned by loops over character class tables ('compile');
+ *  - terms are selected by their first character ('predictive');
+ *  - a factor parses its term once, then wraps it according to the postfix operator or exception that follows it,
+ *    instead of re-parsing the term for each alternative.
  */
 
 
+#include <algorithm>
 #include "parserlib.hpp"
 #include "ebnf.hpp"
 
@@ -11,42 +19,148 @@
 namespace parserlib::ebnf {
 
 
-    using EBNFParseContext = ParseContext<std::string, EBNF, LineCountingSourcePosition<std::string>>;
+    /**
+     * Whitespace and comments.
+     */
+    static const Skipper whitespaceSkipper(" \n\t\r\f\b", "", "(*", "*)");
+
+
+    /**
+     * A parser that skips whitespace and comments; it always succeeds.
+     */
+    class WhitespaceParser : public ParserNode<WhitespaceParser> {
+    public:
+        /**
+         * Skips whitespace and comments.
+         * @param pc parse context.
+         * @return always true.
+         */
+        bool operator ()(EBNFParseContext& pc) const {
+            const auto begin = pc.sourcePosition().iterator();
+            pc.increaseSourcePosition(static_cast<size_t>(whitespaceSkipper.skip(begin, pc.sourceEnd()) - begin));
+            return true;
+        }
+
+        /**
+         * Does nothing; whitespace should not be parsed when a rule is expected to parse.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        bool parseLeftRecursionContinuation(EBNFParseContext& /*pc*/, LeftRecursionContext<EBNFParseContext>& /*lrc*/) const {
+            return false;
+        }
+    };
+
+
+    static const WhitespaceParser WS;
+
+
+    /**
+     * A parser for factors: a term, optionally followed by a postfix operator or by an exception.
+     *
+     * The matches are the same as the ones of the grammar
+     * 'term ? | term * | term + | term - term | term', but the term is parsed once.
+     * @param TermType type of the term parser.
+     */
+    template <class TermType> class FactorParser : public ParserNode<FactorParser<TermType>> {
+    public:
+        /**
+         * Constructor.
+         * @param term the term parser.
+         */
+        FactorParser(const TermType& term) : m_term(term) {
+        }
+
+        /**
+         * Parses a factor.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        bool operator ()(EBNFParseContext& pc) const {
+            const auto begin = pc.sourcePosition();
+            const size_t beginMatchCount = pc.matches().size();
+
+            if (!m_term(pc)) {
+                return false;
+            }
+
+            if (pc.sourceEnded()) {
+                return true;
+            }
+
+            switch (*pc.sourcePosition().iterator()) {
+                case '?':
+                    return postfix(pc, EBNF::TERM_OPTIONAL_POSTFIX, begin, beginMatchCount);
+
+                case '*':
+                    return postfix(pc, EBNF::TERM_REPEATED_0_OR_MORE_POSTFIX, begin, beginMatchCount);
+
+                case '+':
+                    return postfix(pc, EBNF::TERM_REPEATED_1_OR_MORE_POSTFIX, begin, beginMatchCount);
+
+                case '-': {
+                    //if there is no term after '-', the factor is the term alone
+                    const auto state = pc.state();
+                    pc.increaseSourcePosition(1);
+                    WS(pc);
+                    if (m_term(pc)) {
+                        pc.addMatch(EBNF::EXCEPTION, begin, pc.sourcePosition(), pc.matches().size() - beginMatchCount);
+                    }
+                    else {
+                        pc.setState(state);
+                    }
+                    return true;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * Does nothing; the grammar has no left recursion.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        bool parseLeftRecursionContinuation(EBNFParseContext& /*pc*/, LeftRecursionContext<EBNFParseContext>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        const TermType m_term;
+
+        static bool postfix(EBNFParseContext& pc, EBNF id, const EBNFParseContext::PositionType& begin, size_t beginMatchCount) {
+            pc.increaseSourcePosition(1);
+            WS(pc);
+            pc.addMatch(id, begin, pc.sourcePosition(), pc.matches().size() - beginMatchCount);
+            return true;
+        }
+    };
 
 
     extern const Rule<EBNFParseContext> alternation;
 
 
-    static const auto letter = terminalRange('a', 'z') 
+    static const auto letter = terminalRange('a', 'z')
                              | terminalRange('A', 'Z');
 
 
     static const auto digit = terminalRange('0', '9');
 
 
+    //symbols, except for quotes
     static const auto symbol = terminalSet(
         '[', ']', '{', '}', '(', ')', '<', '>',
-        '\'', '\"', '=', '|', '.', ',', ';', '-',
+        '=', '|', '.', ',', ';', '-',
         '+', '*', '?', '\n', '\t', '\r', '\f', '\b');
 
 
-    static const auto character = letter | digit | symbol | '_' | ' ';
+    static const auto identifier = compile((letter >> *(letter | digit | '_' | '-')) == EBNF::IDENTIFIER);
 
 
-    static const auto identifier = (letter >> *(letter | digit | '_' | '-')) == EBNF::IDENTIFIER;
-
-
-    static const auto S = *(terminalSet(' ', '\n', '\t', '\r', '\f', '\b'));
-
-
-    static const auto comment = "(*" >> *(character - "*)") >> "*)";
-
-
-    static const auto WS = *(comment | S);
-
-
-    static const auto terminal = ('\'' >> +(character - '\'') >> '\''
-                               | '\"' >> +(character - '\"') >> '\"') == EBNF::TERMINAL;
+    static const auto terminal = ('\'' >> compile(+(letter | digit | symbol | '\"' | '_' | ' ')) >> '\''
+                               | '\"' >> compile(+(letter | digit | symbol | '\'' | '_' | ' ')) >> '\"') == EBNF::TERMINAL;
 
 
     static const auto terminator = terminalSet(';', '.');
@@ -61,44 +175,40 @@ namespace parserlib::ebnf {
     static const auto repeated_term = ('{' >> WS >> alternation >> '}' >> WS) >= EBNF::TERM_REPEATED;
 
 
-    static const auto term = grouped_term
-                           | optional_term
-                           | repeated_term
-                           | terminal >> WS
-                           | identifier >> WS;
+    static const auto term = predictive(grouped_term
+                                      | optional_term
+                                      | repeated_term
+                                      | terminal >> WS
+                                      | identifier >> WS);
 
 
-    static const auto optional_term_postfix = (term >> '?' >> WS) >= EBNF::TERM_OPTIONAL_POSTFIX;
+    static const auto factor = FactorParser<std::decay_t<decltype(term)>>(term);
 
 
-    static const auto repeated_term_0_postfix = term >> '*' >> WS >= EBNF::TERM_REPEATED_0_OR_MORE_POSTFIX;
+    static const auto concatenation = list(factor, ',' >> WS) >= EBNF::CONCATENATION;
 
 
-    static const auto repeated_term_1_postfix = (term >> '+' >> WS) >= EBNF::TERM_REPEATED_1_OR_MORE_POSTFIX;
+    const Rule<EBNFParseContext> alternation = list(concatenation, '|' >> WS) >= EBNF::ALTERNATION;
 
 
-    static const auto exception = (term >> '-' >> WS >> term) >= EBNF::EXCEPTION;
-
-
-    static const auto factor = optional_term_postfix
-                             | repeated_term_0_postfix
-                             | repeated_term_1_postfix
-                             | exception
-                             | term;
-
-
-    static const auto concatenation = (factor >> *(',' >> WS >> factor)) >= EBNF::CONCATENATION;
+    static const auto rule = (WS >> identifier >> WS >> '=' >> WS >> alternation >> terminator) >= EBNF::RULE;
 
 
-    static const Rule<EBNFParseContext> alternation = (concatenation >> *('|' >> WS >> concatenation)) >= EBNF::ALTERNATION;
+    static const auto grammar = *rule >> WS >> eof();
 
 
-    static const auto rule = (WS >> identifier >> WS >> '=' >> WS >> alternation >> terminator) >= EBNF::RULE;
+    bool parse(EBNFParseContext& pc) {
+        return grammar(pc);
+    }
 
 
-    static const auto ebnf = *rule;
+    std::pair<size_t, size_t> lineAndColumn(const std::string& source, const SourcePosition<std::string>& position) {
+        const auto begin = source.begin();
+        const auto end = position.iterator();
+        const size_t line = 1 + static_cast<size_t>(std::count(begin, end, '\n'));
+        const auto lineBegin = std::find(std::make_reverse_iterator(end), std::make_reverse_iterator(begin), '\n').base();
+        return { line, 1 + static_cast<size_t>(end - lineBegin) };
+    }
 
 
 } //namespace parserlib::ebnf
-
-
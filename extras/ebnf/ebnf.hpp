@@ -2,8 +2,11 @@
 #define PARSERLIB_EBNF_HPP
 
 
+#include <string>
+#include <utility>
 #include "parserlib/Match.hpp"
-#include "parserlib/LineCountingSourcePosition.hpp"
+#include "parserlib/SourcePosition.hpp"
+#include "parserlib/ParseContext.hpp"
 
 
 namespace parserlib::ebnf {
@@ -75,10 +78,34 @@ namespace parserlib::ebnf {
     };
 
 
+    /**
+     * Parse context type for EBNF.
+     * Positions do not count lines while parsing; the line and column of a position are computed by 'lineAndColumn'.
+     */
+    using EBNFParseContext = ParseContext<std::string, EBNF, SourcePosition<std::string>>;
+
+
     /**
      * Match type for EBNF parser.
      */
-    using Match = parserlib::Match<std::string, EBNF, LineCountingSourcePosition<std::string>>;
+    using Match = EBNFParseContext::MatchType;
+
+
+    /**
+     * Parses an EBNF grammar, i.e. a list of rules; whitespace and comments are allowed between tokens.
+     * @param pc parse context; the grammar must end at the end of its source.
+     * @return true if parsing succeeds, false otherwise.
+     */
+    bool parse(EBNFParseContext& pc);
+
+
+    /**
+     * Computes the line and column of a source position, e.g. of a match or of an error.
+     * @param source the source.
+     * @param position position within the source.
+     * @return the line and the column of the position, both starting from 1.
+     */
+    std::pair<size_t, size_t> lineAndColumn(const std::string& source, const SourcePosition<std::string>& position);
 
 
 } //namespace parserlib::ebnf
@@ -0,0 +1,98 @@
+/*
+ * JSON benchmark.
+ *
+ * Usage:
+ *  benchmark file...       parses each file (e.g. the standard test files twitter.json, citm_catalog.json, canada.json)
+ *  benchmark -g megabytes  parses generated documents of 64 MB each, up to the given total size
+ *
+ * For each input, it reports the throughput of parsing (matches only) and of parsing plus building values.
+ * Build: g++ -std=c++17 -O2 -I../../include -I.. benchmark.cpp json.cpp -o benchmark
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "json.hpp"
+
+
+using namespace parserlib::json;
+
+
+//generates a document of about the given size: an array of records with strings, numbers, literals and nested values
+static std::string generate(size_t size, unsigned seed) {
+    std::string result = "[";
+    result.reserve(size + 256);
+    for (unsigned index = 0; result.size() < size; ++index) {
+        const unsigned id = seed * 2654435761u + index;
+        if (index > 0) {
+            result += ",\n";
+        }
+        result += "  {\"id\": " + std::to_string(id);
+        result += ", \"name\": \"user_" + std::to_string(id % 100000) + "\"";
+        result += ", \"text\": \"Lorem ipsum dolor sit amet, \\\"consectetur\\\" adipiscing elit\\n\\u00e9\"";
+        result += ", \"score\": " + std::to_string(static_cast<double>(id % 10000) / 7.0);
+        result += ", \"active\": " + std::string(id % 3 ? "true" : "false");
+        result += ", \"parent\": null";
+        result += ", \"tags\": [\"a\", \"bc\", \"def\"]";
+        result += ", \"position\": {\"x\": " + std::to_string(id % 1000) + ", \"y\": -" + std::to_string(id % 777) + ".5e-3}}";
+    }
+    result += "\n]\n";
+    return result;
+}
+
+
+//parses the input, and reports the throughput
+static bool run(const std::string& name, const std::string& input) {
+    using Clock = std::chrono::steady_clock;
+    const double megabytes = static_cast<double>(input.size()) / (1024.0 * 1024.0);
+
+    JSONParseContext pc(input);
+    const auto start = Clock::now();
+    const bool ok = parse(pc);
+    const auto parsed = Clock::now();
+    if (!ok || pc.matches().size() != 1) {
+        std::cout << name << ": parsing failed\n";
+        return false;
+    }
+    const Value value = toValue(pc.matches()[0]);
+    const auto converted = Clock::now();
+
+    const double parseSeconds = std::chrono::duration<double>(parsed - start).count();
+    const double totalSeconds = std::chrono::duration<double>(converted - start).count();
+    std::cout << name << ": " << megabytes << " MB, parse " << megabytes / parseSeconds << " MB/s, parse + values " << megabytes / totalSeconds << " MB/s\n";
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "usage: benchmark file... | benchmark -g megabytes\n";
+        return 1;
+    }
+
+    bool ok = true;
+
+    if (std::string(argv[1]) == "-g" && argc > 2) {
+        const size_t totalSize = static_cast<size_t>(std::atof(argv[2]) * 1024 * 1024);
+        const size_t documentSize = 64 * 1024 * 1024;
+        unsigned seed = 0;
+        for (size_t size = 0; size < totalSize; size += documentSize) {
+            ok = run("generated #" + std::to_string(seed), generate(std::min(documentSize, totalSize - size), seed)) && ok;
+            ++seed;
+        }
+    }
+    else {
+        for (int index = 1; index < argc; ++index) {
+            std::ifstream file(argv[index], std::ios::binary);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            ok = file && run(argv[index], stream.str()) && ok;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
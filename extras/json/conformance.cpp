@@ -0,0 +1,126 @@
+/*
+ * JSON conformance test: documents that RFC 8259 accepts must be parsed, and documents it rejects must not.
+ *
+ * Usage:
+ *  conformance             exits with 0 if all cases pass, 1 otherwise; failed cases are printed
+ *
+ * Build: g++ -std=c++17 -I../../include -I.. conformance.cpp json.cpp -o conformance
+ */
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "json.hpp"
+
+
+using namespace parserlib::json;
+
+
+//documents that must be accepted
+static const char* const validDocuments[] = {
+    "0",
+    "-0",
+    "1",
+    "-1",
+    "10",
+    "123456789",
+    "0.5",
+    "-0.5",
+    "1.25",
+    "1e3",
+    "1E3",
+    "1e+3",
+    "1e-3",
+    "0e0",
+    "-1.5E-10",
+    "[0, 1, 10, -0.5, 2e2]",
+    "{\"a\": 1.0, \"b\": [-2]}",
+    " [ 1 , 2 ] ",
+    "\"\"",
+    "\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\\u00e9\"",
+    "true",
+    "false",
+    "null",
+    "[]",
+    "{}",
+    "[[[]]]",
+    "{\"a\": {\"b\": {}}}"
+};
+
+
+//documents that must be rejected
+static const char* const invalidDocuments[] = {
+    "",
+    " ",
+    ".5",
+    "-.5",
+    "[.5]",
+    "01",
+    "[01]",
+    "-01",
+    "00",
+    "1.",
+    "[1.]",
+    "1.e3",
+    "-",
+    "[-]",
+    "+1",
+    "1e",
+    "1e+",
+    "[1e]",
+    "0x10",
+    "Infinity",
+    "NaN",
+    "1 2",
+    "[1,]",
+    "[,1]",
+    "{\"a\" 1}",
+    "{\"a\": 1,}",
+    "{a: 1}",
+    "'a'",
+    "\"a",
+    "\"\\x\"",
+    "\"\\u12\"",
+    "\"\t\"",
+    "tru",
+    "nul",
+    "[1] x"
+};
+
+
+int main() {
+    size_t failures = 0;
+
+    for (const char* document : validDocuments) {
+        Value value;
+        if (!parse(document, value)) {
+            std::cout << "rejected valid document: " << document << std::endl;
+            ++failures;
+        }
+    }
+
+    for (const char* document : invalidDocuments) {
+        Value value;
+        if (parse(document, value)) {
+            std::cout << "accepted invalid document: " << document << std::endl;
+            ++failures;
+        }
+    }
+
+    //numbers are converted exactly as written
+    {
+        Value value;
+        if (!parse("[-0.5, 1e3, 10]", value) || value.as<Value::Array>().size() != 3 ||
+            value.as<Value::Array>()[0].as<double>() != -0.5 ||
+            value.as<Value::Array>()[1].as<double>() != 1000.0 ||
+            value.as<Value::Array>()[2].as<double>() != 10.0)
+        {
+            std::cout << "numbers were not converted correctly" << std::endl;
+            ++failures;
+        }
+    }
+
+    std::cout << (failures ? "FAILED: " : "passed: ") << failures << " failure(s)" << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
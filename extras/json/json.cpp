@@ -0,0 +1,398 @@
+/*
+ * JSON grammar, as specified in
+ * https://www.rfc-editor.org/rfc/rfc8259
+ *
+ * It shows how to write a high-throughput grammar:
+ *  - whitespace is skipped by a skipper, 16 bytes at a time;
+ *  - strings are scanned by a custom terminal, 16 bytes at a time, up to the next quote, backslash or control character;
+ *  - numbers are validated and converted while parsed, without a second pass over the match content;
+ *  - only values are captured, and object members are not;
+ *  - values are selected by their first character ('predictive'), without backtracking.
+ */
+
+
+#include <charconv>
+#include <cstring>
+#include "parserlib.hpp"
+#include "json.hpp"
+
+
+namespace parserlib::json {
+
+
+    /**
+     * A parser for JSON strings; it validates escape sequences, and rejects unescaped control characters.
+     */
+    class StringParser : public ParserNode<StringParser> {
+    public:
+        /**
+         * Parses a string.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        bool operator ()(JSONParseContext& pc) const {
+            return pc.parseAfterSkip([&]() {
+                if (pc.sourceEnded() || *pc.sourcePosition().iterator() != '"') {
+                    return fail(pc, 0, "Syntax error: expected string");
+                }
+
+                const char* const begin = toPointer(pc.sourcePosition().iterator());
+                const char* const end = begin + (pc.sourceEnd() - pc.sourcePosition().iterator());
+                const char* it = begin + 1;
+
+                for (;;) {
+                    it = findSpecial(it, end);
+                    if (it == end) {
+                        return fail(pc, static_cast<size_t>(it - begin), "Syntax error: unterminated string");
+                    }
+                    if (*it == '"') {
+                        pc.increaseSourcePosition(static_cast<size_t>(it + 1 - begin));
+                        return true;
+                    }
+                    if (*it != '\\') {
+                        return fail(pc, static_cast<size_t>(it - begin), "Syntax error: control character in string");
+                    }
+                    const char* const escapeEnd = skipEscape(it, end);
+                    if (!escapeEnd) {
+                        return fail(pc, static_cast<size_t>(it - begin), "Syntax error: invalid escape sequence");
+                    }
+                    it = escapeEnd;
+                }
+                });
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        bool parseLeftRecursionContinuation(JSONParseContext& /*pc*/, LeftRecursionContext<JSONParseContext>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        //adds an error at the given offset from the current position
+        static bool fail(JSONParseContext& pc, size_t offset, const char* msg) {
+            auto pos = pc.sourcePosition();
+            pos.increase(offset);
+            pc.addError(pos, [&]() { return makeError(ErrorType::SyntaxError, pos, msg); });
+            return false;
+        }
+
+        static bool isSpecial(char c) {
+            return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+        }
+
+        //finds the next quote, backslash or control character
+        static const char* findSpecial(const char* it, const char* end) {
+            #ifdef PARSERLIB_SSE2
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i maxControl = _mm_set1_epi8(0x1f);
+            while (end - it >= 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxControl), maxControl);
+                const __m128i mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), control);
+                const unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(mask));
+                if (bits) {
+                    return it + countTrailingZeros(bits);
+                }
+                it += 16;
+            }
+            #endif
+            for (; it != end && !isSpecial(*it); ++it) {
+            }
+            return it;
+        }
+
+        static bool isHexDigit(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        //returns the end of the escape sequence at the given backslash, or null if the sequence is invalid
+        static const char* skipEscape(const char* it, const char* end) {
+            if (end - it < 2) {
+                return nullptr;
+            }
+            switch (it[1]) {
+                case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                    return it + 2;
+                case 'u':
+                    if (end - it < 6 || !isHexDigit(it[2]) || !isHexDigit(it[3]) || !isHexDigit(it[4]) || !isHexDigit(it[5])) {
+                        return nullptr;
+                    }
+                    return it + 6;
+                default:
+                    return nullptr;
+            }
+        }
+    };
+
+
+    /**
+     * Computes the first set of a string parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the quote.
+     */
+    inline FirstSet computeFirstSet(const StringParser& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.add('"');
+        return result;
+    }
+
+
+    /**
+     * A parser for JSON numbers; the syntax is '-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?',
+     * which is stricter than the one of 'floatNumber': leading zeros, and a missing integer or fraction part, are rejected.
+     */
+    class NumberParser : public ValueParserNode<NumberParser> {
+    public:
+        /**
+         * Parses a number.
+         * @param pc parse context.
+         * @param value the result value; stored as 'double'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        bool parseValue(JSONParseContext& pc, MatchValue& value) const {
+            return pc.parseAfterSkip([&]() {
+                const char* const begin = toPointer(pc.sourcePosition().iterator());
+                const char* const end = begin + (pc.sourceEnd() - pc.sourcePosition().iterator());
+                const char* const numberEnd = skipNumber(begin, end);
+                if (!numberEnd) {
+                    pc.addError(pc.sourcePosition(), [&]() { return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: invalid number"); });
+                    return false;
+                }
+                double result;
+                if (std::from_chars(begin, numberEnd, result).ec != std::errc()) {
+                    pc.addError(pc.sourcePosition(), [&]() { return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: number out of range"); });
+                    return false;
+                }
+                value = result;
+                pc.increaseSourcePosition(static_cast<size_t>(numberEnd - begin));
+                return true;
+                });
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        bool parseLeftRecursionContinuation(JSONParseContext& /*pc*/, LeftRecursionContext<JSONParseContext>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        static bool isDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        static const char* skipDigits(const char* it, const char* end) {
+            for (; it != end && isDigit(*it); ++it) {
+            }
+            return it;
+        }
+
+        //returns the end of the number at the given position, or null if there is no valid number
+        static const char* skipNumber(const char* it, const char* end) {
+            if (it != end && *it == '-') {
+                ++it;
+            }
+
+            //integer part: '0' or a non-zero digit followed by digits
+            if (it == end || !isDigit(*it)) {
+                return nullptr;
+            }
+            it = *it == '0' ? it + 1 : skipDigits(it, end);
+
+            //fraction part
+            if (it != end && *it == '.') {
+                if (end - it < 2 || !isDigit(it[1])) {
+                    return nullptr;
+                }
+                it = skipDigits(it + 1, end);
+            }
+
+            //exponent part
+            if (it != end && (*it == 'e' || *it == 'E')) {
+                ++it;
+                if (it != end && (*it == '+' || *it == '-')) {
+                    ++it;
+                }
+                if (it == end || !isDigit(*it)) {
+                    return nullptr;
+                }
+                it = skipDigits(it, end);
+            }
+
+            return it;
+        }
+    };
+
+
+    /**
+     * Computes the first set of a number parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the minus sign and the digits.
+     */
+    inline FirstSet computeFirstSet(const NumberParser& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.addRange('0', '9');
+        result.add('-');
+        return result;
+    }
+
+
+    extern const Rule<JSONParseContext> value;
+
+
+    static const auto string = StringParser() == JSON::STRING;
+
+
+    static const auto number = NumberParser() == JSON::NUMBER;
+
+
+    static const auto member = string >> ':' >> value;
+
+
+    static const auto object = ('{' >> list(member, ',', 0) >> '}') >= JSON::OBJECT;
+
+
+    static const auto array = ('[' >> list(RuleReference<JSONParseContext>(value), ',', 0) >> ']') >= JSON::ARRAY;
+
+
+    const Rule<JSONParseContext> value = predictive(object
+                                                  | array
+                                                  | string
+                                                  | number
+                                                  | (terminal("true") == JSON::TRUE_LITERAL)
+                                                  | (terminal("false") == JSON::FALSE_LITERAL)
+                                                  | (terminal("null") == JSON::NULL_LITERAL));
+
+
+    static const auto document = skip(Skipper(" \t\r\n"), value >> eof());
+
+
+    bool parse(JSONParseContext& pc) {
+        return document(pc);
+    }
+
+
+    //appends a code point to a string, encoded in UTF-8
+    static void appendUTF8(std::string& str, unsigned long codePoint) {
+        if (codePoint < 0x80) {
+            str += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800) {
+            str += static_cast<char>(0xC0 | (codePoint >> 6));
+            str += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000) {
+            str += static_cast<char>(0xE0 | (codePoint >> 12));
+            str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            str += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else {
+            str += static_cast<char>(0xF0 | (codePoint >> 18));
+            str += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            str += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+
+    //decodes the contents of a string match; escape sequences are valid, since the string was parsed
+    static std::string decodeString(const Match& match) {
+        const char* it = toPointer(match.begin().iterator()) + 1;
+        const char* const end = toPointer(match.begin().iterator()) + (match.end().iterator() - match.begin().iterator()) - 1;
+        std::string result;
+        result.reserve(static_cast<size_t>(end - it));
+        for (;;) {
+            const char* const backslash = static_cast<const char*>(std::memchr(it, '\\', static_cast<size_t>(end - it)));
+            if (!backslash) {
+                result.append(it, end);
+                return result;
+            }
+            result.append(it, backslash);
+            it = backslash + 2;
+            switch (backslash[1]) {
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': {
+                    unsigned long codePoint = std::stoul(std::string(it, it + 4), nullptr, 16);
+                    it += 4;
+
+                    //surrogate pair
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - it >= 6 && it[0] == '\\' && it[1] == 'u') {
+                        const unsigned long low = std::stoul(std::string(it + 2, it + 6), nullptr, 16);
+                        if (low >= 0xDC00 && low < 0xE000) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                            it += 6;
+                        }
+                    }
+
+                    appendUTF8(result, codePoint);
+                    break;
+                }
+                default: result += backslash[1]; break;
+            }
+        }
+    }
+
+
+    Value toValue(const Match& match) {
+        switch (match.id()) {
+            case JSON::OBJECT: {
+                Value::Object object;
+                object.reserve(match.children().size() / 2);
+                for (size_t index = 0; index + 1 < match.children().size(); index += 2) {
+                    object.emplace_back(decodeString(match.children()[index]), toValue(match.children()[index + 1]));
+                }
+                return Value(std::move(object));
+            }
+
+            case JSON::ARRAY: {
+                Value::Array array;
+                array.reserve(match.children().size());
+                for (const Match& child : match.children()) {
+                    array.push_back(toValue(child));
+                }
+                return Value(std::move(array));
+            }
+
+            case JSON::STRING:
+                return Value(decodeString(match));
+
+            case JSON::NUMBER:
+                return Value(match.valueAs<double>());
+
+            case JSON::TRUE_LITERAL:
+                return Value(true);
+
+            case JSON::FALSE_LITERAL:
+                return Value(false);
+
+            default:
+                return Value();
+        }
+    }
+
+
+    bool parse(const std::string& input, Value& value) {
+        JSONParseContext pc(input);
+        if (!parse(pc) || pc.matches().size() != 1) {
+            return false;
+        }
+        value = toValue(pc.matches()[0]);
+        return true;
+    }
+
+
+} //namespace parserlib::json
@@ -0,0 +1,158 @@
+#ifndef PARSERLIB_JSON_HPP
+#define PARSERLIB_JSON_HPP
+
+
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "parserlib/Match.hpp"
+#include "parserlib/SourcePosition.hpp"
+#include "parserlib/ParseContext.hpp"
+
+
+namespace parserlib::json {
+
+
+    /**
+     * JSON match ids.
+     * Only values are captured; the members of an object are its children, as key and value pairs.
+     */
+    enum class JSON {
+        /**
+         * Object; its children are the keys (strings) and the values of its members.
+         */
+        OBJECT,
+
+        /**
+         * Array; its children are its elements.
+         */
+        ARRAY,
+
+        /**
+         * String; its content includes the quotes, and escape sequences are not decoded.
+         */
+        STRING,
+
+        /**
+         * Number; the match value is the number, as 'double'.
+         */
+        NUMBER,
+
+        /**
+         * The literal 'true'.
+         */
+        TRUE_LITERAL,
+
+        /**
+         * The literal 'false'.
+         */
+        FALSE_LITERAL,
+
+        /**
+         * The literal 'null'.
+         */
+        NULL_LITERAL
+    };
+
+
+    /**
+     * Parse context type for JSON.
+     */
+    using JSONParseContext = ParseContext<std::string, JSON, SourcePosition<std::string>>;
+
+
+    /**
+     * Match type for JSON.
+     */
+    using Match = JSONParseContext::MatchType;
+
+
+    /**
+     * A JSON value.
+     */
+    class Value {
+    public:
+        /**
+         * Array type.
+         */
+        using Array = std::vector<Value>;
+
+        /**
+         * Object type; members are kept in the order of the source.
+         */
+        using Object = std::vector<std::pair<std::string, Value>>;
+
+        /**
+         * Data type.
+         */
+        using Data = std::variant<std::nullptr_t, bool, double, std::string, Array, Object>;
+
+        /**
+         * Constructor.
+         * @param data data of the value; null by default.
+         */
+        Value(Data&& data = nullptr) : m_data(std::move(data)) {
+        }
+
+        /**
+         * Returns the data of the value.
+         * @return the data of the value.
+         */
+        const Data& data() const {
+            return m_data;
+        }
+
+        /**
+         * Checks if the value is of the given type.
+         * @param T one of the types of Data.
+         * @return true if the value is of the given type, false otherwise.
+         */
+        template <class T> bool is() const {
+            return std::holds_alternative<T>(m_data);
+        }
+
+        /**
+         * Returns the value as the given type.
+         * @param T one of the types of Data.
+         * @return the value as the given type.
+         * @exception std::bad_variant_access thrown if the value is not of the given type.
+         */
+        template <class T> const T& as() const {
+            return std::get<T>(m_data);
+        }
+
+    private:
+        Data m_data;
+    };
+
+
+    /**
+     * Parses a JSON document; whitespace is skipped.
+     * @param pc parse context; the document must end at the end of its source.
+     * @return true if parsing succeeds, false otherwise.
+     */
+    bool parse(JSONParseContext& pc);
+
+
+    /**
+     * Converts a match to a JSON value; escape sequences of strings are decoded to UTF-8.
+     * @param match the match.
+     * @return the JSON value.
+     */
+    Value toValue(const Match& match);
+
+
+    /**
+     * Parses a JSON document and converts it to a value.
+     * @param input the document.
+     * @param value the result value.
+     * @return true if parsing succeeds, false otherwise.
+     */
+    bool parse(const std::string& input, Value& value);
+
+
+} //namespace parserlib::json
+
+
+#endif //PARSERLIB_JSON_HPP
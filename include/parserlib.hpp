@@ -8,7 +8,25 @@
 #include "parserlib/TerminalSetParser.hpp"
 #include "parserlib/EOFParser.hpp"
 #include "parserlib/EmptyParser.hpp"
+#include "parserlib/NumberParser.hpp"
+#include "parserlib/BinaryParser.hpp"
+#include "parserlib/ListParser.hpp"
+#include "parserlib/AdaptiveChoiceParser.hpp"
+#include "parserlib/PredictiveParser.hpp"
+#include "parserlib/MemoParser.hpp"
+#include "parserlib/CharClassParser.hpp"
+#include "parserlib/BoundaryParser.hpp"
+#include "parserlib/SymbolParser.hpp"
 #include "parserlib/Rule.hpp"
+#include "parserlib/Search.hpp"
+#include "parserlib/ParseEach.hpp"
+#include "parserlib/Batch.hpp"
+#include "parserlib/MatchDag.hpp"
+#include "parserlib/MatchIndex.hpp"
+#include "parserlib/FlatMatch.hpp"
+#include "parserlib/FlatMatchStore.hpp"
+#include "parserlib/RopeSource.hpp"
+#include "parserlib/PaddedSource.hpp"
 #include "parserlib/util.hpp"
 
 
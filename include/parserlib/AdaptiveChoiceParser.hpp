@@ -0,0 +1,280 @@
+#ifndef PARSERLIB_ADAPTIVECHOICEPARSER_HPP
+#define PARSERLIB_ADAPTIVECHOICEPARSER_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "ParserNode.hpp"
+#include "ChoiceParser.hpp"
+#include "FirstSet.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A choice of parsers that tries its alternatives in the order of how often they succeed.
+     *
+     * Alternatives are reordered only if the grammar analysis proves that the order does not affect the result,
+     * i.e. if no alternative is nullable and the first sets of the alternatives are pairwise disjoint:
+     * then at most one alternative can succeed at any position. Otherwise, the alternatives are tried in the given order.
+     * The analysis takes place on the first parse, so as that the rules referenced by the alternatives can be defined
+     * after the choice is created; the first sets are computed case insensitively, which makes the proof hold
+     * in both case modes: first sets that are disjoint case insensitively are also disjoint case sensitively.
+     *
+     * The statistics (the number of successes of each alternative) are shared between the copies of the parser,
+     * and they can be saved after a training run and restored later.
+     * If reordering at runtime is enabled, then the order is recomputed every 'ReorderInterval' successful parses.
+     *
+     * When the alternatives are reordered, the result, the source position and the matches are the same as
+     * in the given order; the reported error may be a different one of the errors at the same position.
+     * @param Children children parser nodes.
+     */
+    template <class ...Children> class AdaptiveChoiceParser : public ParserNode<AdaptiveChoiceParser<Children...>> {
+    public:
+        /**
+         * Max number of alternatives that can be reordered.
+         */
+        static constexpr size_t MaxReorderedCount = 16;
+
+        /**
+         * Number of successful parses after which the alternatives are reordered, if reordering at runtime is enabled.
+         */
+        static constexpr std::uint64_t ReorderInterval = 1024;
+
+        /**
+         * Constructor.
+         * @param children children nodes.
+         * @param reorderAtRuntime if true, the alternatives are reordered from statistics gathered while parsing;
+         *  otherwise, they are reordered only when statistics are set.
+         */
+        AdaptiveChoiceParser(const std::tuple<Children...>& children, bool reorderAtRuntime = true)
+            : m_children(children), m_statistics(std::make_shared<Statistics>(reorderAtRuntime)) {
+        }
+
+        /**
+         * Returns the children nodes.
+         * @return the children nodes.
+         */
+        const std::tuple<Children...>& children() const {
+            return m_children;
+        }
+
+        /**
+         * Checks if the alternatives can be reordered without affecting the result.
+         * The analysis takes place once, and its result holds in both case modes.
+         * @return true if the alternatives can be reordered, false otherwise.
+         */
+        bool reorderable() const {
+            std::call_once(m_statistics->analysisFlag, [&]() {
+                m_statistics->reorderable = analyze();
+            });
+            return m_statistics->reorderable;
+        }
+
+        /**
+         * Returns the current order of the alternatives.
+         * @return indexes of the alternatives, in the order they are tried.
+         */
+        std::vector<size_t> order() const {
+            const std::uint64_t order = m_statistics->order.load(std::memory_order_relaxed);
+            std::vector<size_t> result(sizeof...(Children));
+            for (size_t index = 0; index < result.size(); ++index) {
+                result[index] = index < MaxReorderedCount ? orderIndex(order, index) : index;
+            }
+            return result;
+        }
+
+        /**
+         * Returns the number of successes of each alternative.
+         * @return the number of successes of each alternative, in the given order of alternatives.
+         */
+        std::vector<std::uint64_t> statistics() const {
+            std::vector<std::uint64_t> result(sizeof...(Children));
+            for (size_t index = 0; index < result.size(); ++index) {
+                result[index] = m_statistics->hits[index].load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        /**
+         * Sets the number of successes of each alternative, e.g. from a training run, and reorders the alternatives.
+         * It shall not be invoked while parsing.
+         * @param hits the number of successes of each alternative, in the given order of alternatives.
+         */
+        void setStatistics(const std::vector<std::uint64_t>& hits) {
+            for (size_t index = 0; index < sizeof...(Children); ++index) {
+                m_statistics->hits[index].store(index < hits.size() ? hits[index] : 0, std::memory_order_relaxed);
+            }
+            reorder();
+        }
+
+        /**
+         * Invokes the child parsers, in the current order, until one returns true.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            const auto errorState = pc.errorState();
+
+            if (!reorderable()) {
+                for (size_t index = 0; index < sizeof...(Children); ++index) {
+                    if (parseChild<0>(index, pc)) {
+                        pc.setErrorState(errorState);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            const std::uint64_t order = m_statistics->order.load(std::memory_order_relaxed);
+            for (size_t orderPosition = 0; orderPosition < sizeof...(Children); ++orderPosition) {
+                const size_t index = orderIndex(order, orderPosition);
+                if (parseChild<0>(index, pc)) {
+                    addHit(index);
+                    pc.setErrorState(errorState);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Invokes the child parsers, in the given order, until one returns true.
+         * The object is called to parse within a left recursion parsing context,
+         * in order to continue parsing after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return ChoiceParser<Children...>(m_children).parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        //state shared between copies of the parser
+        struct Statistics {
+            Statistics(bool reorderAtRuntime) : reorderAtRuntime(reorderAtRuntime), order(identityOrder()) {
+            }
+
+            const bool reorderAtRuntime;
+            std::once_flag analysisFlag;
+            bool reorderable{ false };
+            std::atomic<std::uint64_t> hits[sizeof...(Children)]{};
+            std::atomic<std::uint64_t> hitCount{ 0 };
+
+            //indexes of alternatives, 4 bits each, in the order they are tried
+            std::atomic<std::uint64_t> order;
+        };
+
+        std::tuple<Children...> m_children;
+        std::shared_ptr<Statistics> m_statistics;
+
+        static size_t orderIndex(std::uint64_t order, size_t orderPosition) {
+            return static_cast<size_t>((order >> (orderPosition * 4)) & 0xF);
+        }
+
+        static std::uint64_t identityOrder() {
+            std::uint64_t result = 0;
+            for (size_t index = 0; index < std::min(sizeof...(Children), MaxReorderedCount); ++index) {
+                result |= static_cast<std::uint64_t>(index) << (index * 4);
+            }
+            return result;
+        }
+
+        bool analyze() const {
+            if (sizeof...(Children) < 2 || sizeof...(Children) > MaxReorderedCount) {
+                return false;
+            }
+
+            std::vector<FirstSet> firstSets;
+            std::apply([&](const auto&... children) { (firstSets.push_back(firstSet(children, false)), ...); }, m_children);
+
+            for (size_t index1 = 0; index1 < firstSets.size(); ++index1) {
+                if (firstSets[index1].nullable()) {
+                    return false;
+                }
+                for (size_t index2 = index1 + 1; index2 < firstSets.size(); ++index2) {
+                    if (firstSets[index1].intersects(firstSets[index2])) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void addHit(size_t index) const {
+            m_statistics->hits[index].fetch_add(1, std::memory_order_relaxed);
+            if (m_statistics->reorderAtRuntime && (m_statistics->hitCount.fetch_add(1, std::memory_order_relaxed) + 1) % ReorderInterval == 0) {
+                reorder();
+            }
+        }
+
+        void reorder() const {
+            if (sizeof...(Children) > MaxReorderedCount) {
+                return;
+            }
+            std::uint64_t hits[sizeof...(Children)];
+            size_t indexes[sizeof...(Children)];
+            for (size_t index = 0; index < sizeof...(Children); ++index) {
+                hits[index] = m_statistics->hits[index].load(std::memory_order_relaxed);
+                indexes[index] = index;
+            }
+            std::stable_sort(std::begin(indexes), std::end(indexes), [&](size_t a, size_t b) { return hits[a] > hits[b]; });
+            std::uint64_t order = 0;
+            for (size_t orderPosition = 0; orderPosition < sizeof...(Children); ++orderPosition) {
+                order |= static_cast<std::uint64_t>(indexes[orderPosition]) << (orderPosition * 4);
+            }
+            m_statistics->order.store(order, std::memory_order_relaxed);
+        }
+
+        template <size_t Index, class ParseContextType> bool parseChild(size_t index, ParseContextType& pc) const {
+            if constexpr (Index < sizeof...(Children)) {
+                if (index == Index) {
+                    return std::get<Index>(m_children)(pc);
+                }
+                return parseChild<Index + 1>(index, pc);
+            }
+            else {
+                return false;
+            }
+        }
+    };
+
+
+    /**
+     * Creates a choice that tries its alternatives in the order of how often they succeed,
+     * if the alternatives are provably disjoint.
+     * @param choice choice of parsers.
+     * @param reorderAtRuntime if true, the alternatives are reordered from statistics gathered while parsing;
+     *  otherwise, they are reordered only when statistics are set.
+     * @return an adaptive choice parser.
+     */
+    template <class ...Children>
+    AdaptiveChoiceParser<Children...>
+    adaptive(const ParserNode<ChoiceParser<Children...>>& choice, bool reorderAtRuntime = true) {
+        return { static_cast<const ChoiceParser<Children...>&>(choice).children(), reorderAtRuntime };
+    }
+
+
+    /**
+     * Computes the first set of an adaptive choice; it is the same as the first set of the choice.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the union of the first sets of the children.
+     */
+    template <class ...Children> FirstSet computeFirstSet(const AdaptiveChoiceParser<Children...>& parser, FirstSetContext& context) {
+        return computeFirstSet(ChoiceParser<Children...>(parser.children()), context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_ADAPTIVECHOICEPARSER_HPP
@@ -31,12 +31,30 @@ namespace parserlib {
 
         /**
          * Invokes the child parser, then returns the result.
-         * The parser state is restored after the invocation of the child parser.
+         * The parser state is restored after the invocation of the child parser;
+         * if the child parser can peek (e.g. it is a terminal), then it peeks instead,
+         * so as that no state is saved and restored, and no errors are created.
          * @param pc parse context.
          * @return true if parsing succeeds, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            return parse(pc, [&]() { return m_child(pc); });
+            if constexpr (CanPeek<ParserNodeType, ParseContextType>::value) {
+                return m_child.peek(pc);
+            }
+            else {
+                return parse(pc, [&]() { return m_child(pc); });
+            }
+        }
+
+        /**
+         * Returns the result of the child parser at the current position, without changing the parse context;
+         * available only if the child parser can peek.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType>
+        auto peek(ParseContextType& pc) const -> std::enable_if_t<CanPeek<ParserNodeType, ParseContextType>::value, bool> {
+            return m_child.peek(pc);
         }
 
         /**
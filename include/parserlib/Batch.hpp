@@ -0,0 +1,115 @@
+#ifndef PARSERLIB_BATCH_HPP
+#define PARSERLIB_BATCH_HPP
+
+
+#include <iterator>
+#include <vector>
+#include "ParseContext.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * The result of parsing one input of a batch.
+     */
+    class BatchResult {
+    public:
+        /**
+         * The default constructor.
+         * The result is a failure at offset 0, without error.
+         */
+        BatchResult() {
+        }
+
+        /**
+         * Constructor.
+         * @param success true if the parser succeeded, false otherwise.
+         * @param endOffset offset of the position the parser stopped at.
+         * @param errorType type of the first error; -1 if there was no error.
+         */
+        BatchResult(bool success, size_t endOffset, int errorType)
+            : m_endOffset(endOffset), m_errorType(errorType), m_success(success) {
+        }
+
+        /**
+         * Returns the success flag.
+         * @return true if the parser succeeded, false otherwise.
+         */
+        bool success() const {
+            return m_success;
+        }
+
+        /**
+         * Returns the offset of the position the parser stopped at;
+         * on success, it can be compared with the size of the input to check if the whole input was parsed.
+         * @return the offset of the position the parser stopped at.
+         */
+        size_t endOffset() const {
+            return m_endOffset;
+        }
+
+        /**
+         * Returns the type of the first error.
+         * @return the type of the first error; -1 if there was no error.
+         */
+        int errorType() const {
+            return m_errorType;
+        }
+
+    private:
+        size_t m_endOffset{ 0 };
+        int m_errorType{ -1 };
+        bool m_success{ false };
+    };
+
+
+    /**
+     * Parses many inputs with the same parser, reusing one parse context;
+     * the context keeps its memory between inputs, so as that there is no per-input allocation
+     * other than the one needed for reporting an error.
+     * @param parser parser or rule to parse each input with.
+     * @param begin iterator to the first input; inputs must be of the context's source type.
+     * @param end iterator to the end of inputs.
+     * @param result iterator to write a BatchResult to, for each input.
+     * @return the result iterator after the last result written.
+     */
+    template <class ParseContextType = ParseContext<>, class ParserType, class InputIterator, class OutputIterator>
+    OutputIterator parseBatch(const ParserType& parser, InputIterator begin, const InputIterator& end, OutputIterator result) {
+        if (begin == end) {
+            return result;
+        }
+
+        ParseContextType pc(*begin);
+
+        for (; begin != end; ++begin, ++result) {
+            const auto& input = *begin;
+            pc.reset(input);
+            const bool success = parser(pc);
+            const size_t endOffset = static_cast<size_t>(std::distance(input.begin(), pc.sourcePosition().iterator()));
+            const int errorType = pc.errors().empty() ? -1 : pc.errors().front().type();
+            *result = BatchResult(success, endOffset, errorType);
+        }
+
+        return result;
+    }
+
+
+    /**
+     * Parses many inputs with the same parser, reusing one parse context.
+     * @param parser parser or rule to parse each input with.
+     * @param inputs container of inputs; inputs must be of the context's source type.
+     * @return one result per input.
+     */
+    template <class ParseContextType = ParseContext<>, class ParserType, class InputContainerType>
+    std::vector<BatchResult> parseBatch(const ParserType& parser, const InputContainerType& inputs) {
+        std::vector<BatchResult> results(std::size(inputs));
+        parseBatch<ParseContextType>(parser, std::begin(inputs), std::end(inputs), results.begin());
+        return results;
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_BATCH_HPP
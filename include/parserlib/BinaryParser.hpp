@@ -0,0 +1,320 @@
+#ifndef PARSERLIB_BINARYPARSER_HPP
+#define PARSERLIB_BINARYPARSER_HPP
+
+
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include "ValueMatchParser.hpp"
+#include "util.hpp"
+#include "Error.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that parses a fixed-width binary integer of the given endianness.
+     * The source elements must be bytes.
+     * The available size is checked once for the whole integer.
+     * @param T integer type.
+     * @param BigEndian if true, the integer is stored in big endian order, otherwise in little endian order.
+     */
+    template <class T, bool BigEndian> class BinaryIntegerParser
+        : public ValueParserNode<BinaryIntegerParser<T, BigEndian>> {
+    public:
+        static_assert(std::is_integral_v<T>, "T must be an integral type.");
+
+        /**
+         * Parses a binary integer.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses a binary integer; on success, it places the integer in the given value.
+         * @param pc parse context.
+         * @param value the result value; signed integers are stored as 'long long', unsigned integers as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            const auto it = pc.sourcePosition().iterator();
+            const auto available = std::distance(it, pc.sourceEnd());
+
+            if (available < static_cast<std::ptrdiff_t>(sizeof(T))) {
+                if (available > 0) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), toString("Syntax error: expected ", sizeof(T), " bytes, found: ", available));
+                        });
+                }
+                return false;
+            }
+
+            using UnsignedType = std::make_unsigned_t<T>;
+            UnsignedType result = 0;
+            using Iterator = std::decay_t<decltype(it)>;
+            if constexpr (isContiguousIterator<Iterator>() && sizeof(typename std::iterator_traits<Iterator>::value_type) == 1 && !BigEndian && isLittleEndian()) {
+                std::memcpy(&result, toPointer(it), sizeof(T));
+            }
+            else {
+                auto byteIt = it;
+                for (size_t index = 0; index < sizeof(T); ++index, ++byteIt) {
+                    const UnsignedType byte = static_cast<unsigned char>(*byteIt);
+                    if constexpr (BigEndian) {
+                        result = static_cast<UnsignedType>((result << 8) | byte);
+                    }
+                    else {
+                        result = static_cast<UnsignedType>(result | (byte << (index * 8)));
+                    }
+                }
+            }
+
+            if constexpr (std::is_signed_v<T>) {
+                value = static_cast<long long>(static_cast<T>(result));
+            }
+            else {
+                value = static_cast<unsigned long long>(result);
+            }
+            pc.increaseSourcePosition(sizeof(T));
+            return true;
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        static constexpr bool isLittleEndian() {
+            #ifdef PARSERLIB_LITTLE_ENDIAN
+            return true;
+            #else
+            return false;
+            #endif
+        }
+    };
+
+
+    /**
+     * A parser that parses an unsigned LEB128 variable-length integer:
+     * each byte contributes its low 7 bits, least significant group first;
+     * the high bit of a byte is set if more bytes follow.
+     * The available size is checked once for the whole integer.
+     * Parsing fails if the integer does not fit in the given type.
+     * @param T unsigned integer type.
+     */
+    template <class T> class VarintParser
+        : public ValueParserNode<VarintParser<T>> {
+    public:
+        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "T must be an unsigned integral type.");
+
+        /**
+         * Parses a varint.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses a varint; on success, it places the integer in the given value.
+         * @param pc parse context.
+         * @param value the result value; stored as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            constexpr size_t maxByteCount = (sizeof(T) * 8 + 6) / 7;
+
+            if (pc.sourceEnded()) {
+                return false;
+            }
+
+            //bounds check once; the loop is limited by the available byte count
+            auto it = pc.sourcePosition().iterator();
+            const size_t byteCount = static_cast<size_t>(std::min<std::ptrdiff_t>(maxByteCount, std::distance(it, pc.sourceEnd())));
+
+            T result = 0;
+            for (size_t index = 0; index < byteCount; ++index, ++it) {
+                const unsigned byte = static_cast<unsigned char>(*it);
+                const T group = static_cast<T>(byte & 0x7F);
+                const size_t shift = index * 7;
+
+                //check that the group fits in the type
+                if (shift + 7 > sizeof(T) * 8 && (group >> (sizeof(T) * 8 - shift)) != 0) {
+                    break;
+                }
+
+                result |= static_cast<T>(group << shift);
+
+                //last byte
+                if (!(byte & 0x80)) {
+                    value = static_cast<unsigned long long>(result);
+                    pc.increaseSourcePosition(index + 1);
+                    return true;
+                }
+            }
+
+            pc.addError(pc.sourcePosition(), [&]() {
+                return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: invalid varint");
+                });
+            return false;
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+    };
+
+
+    /**
+     * A parser that parses a length-prefixed field:
+     * a length, parsed by a value parser, followed by that many bytes.
+     * The bytes of the field are skipped in O(1), after a single bounds check.
+     * @param LengthParserType type of value parser that parses the length.
+     */
+    template <class LengthParserType> class LengthPrefixedParser
+        : public ValueParserNode<LengthPrefixedParser<LengthParserType>> {
+    public:
+        /**
+         * Constructor.
+         * @param lengthParser parser of the length.
+         */
+        LengthPrefixedParser(const LengthParserType& lengthParser) : m_lengthParser(lengthParser) {
+        }
+
+        /**
+         * Returns the length parser.
+         * @return the length parser.
+         */
+        const LengthParserType& lengthParser() const {
+            return m_lengthParser;
+        }
+
+        /**
+         * Parses a length-prefixed field.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses a length-prefixed field; on success, it places the length of the field's data in the given value.
+         * @param pc parse context.
+         * @param value the result value; stored as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            const auto state = pc.state();
+
+            MatchValue lengthValue;
+            if (!m_lengthParser.parseValue(pc, lengthValue)) {
+                return false;
+            }
+
+            const auto length = std::visit([](const auto& v) -> long long {
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                    return -1;
+                }
+                else {
+                    return static_cast<long long>(v);
+                }
+            }, lengthValue);
+
+            //single bounds check for the whole field
+            const auto available = std::distance(pc.sourcePosition().iterator(), pc.sourceEnd());
+            if (length < 0 || length > available) {
+                pc.setState(state);
+                pc.addError(pc.sourcePosition(), [&]() {
+                    return makeError(ErrorType::SyntaxError, pc.sourcePosition(), toString("Syntax error: field length ", length, " exceeds available bytes"));
+                    });
+                return false;
+            }
+
+            value = static_cast<unsigned long long>(length);
+            pc.increaseSourcePosition(static_cast<size_t>(length));
+            return true;
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        const LengthParserType m_lengthParser;
+    };
+
+
+    /**
+     * Creates a parser for a little endian binary integer.
+     * @param T integer type.
+     * @return a binary integer parser.
+     */
+    template <class T> BinaryIntegerParser<T, false> binaryLE() {
+        return {};
+    }
+
+
+    /**
+     * Creates a parser for a big endian binary integer.
+     * @param T integer type.
+     * @return a binary integer parser.
+     */
+    template <class T> BinaryIntegerParser<T, true> binaryBE() {
+        return {};
+    }
+
+
+    /**
+     * Creates a parser for an unsigned LEB128 variable-length integer.
+     * @param T unsigned integer type.
+     * @return a varint parser.
+     */
+    template <class T = unsigned long long> VarintParser<T> varint() {
+        return {};
+    }
+
+
+    /**
+     * Creates a parser for a length-prefixed field.
+     * @param lengthParser value parser for the length.
+     * @return a length-prefixed parser.
+     */
+    template <class LengthParserType>
+    LengthPrefixedParser<LengthParserType> lengthPrefixed(const ValueParserNode<LengthParserType>& lengthParser) {
+        return { static_cast<const LengthParserType&>(lengthParser) };
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_BINARYPARSER_HPP
@@ -0,0 +1,296 @@
+#ifndef PARSERLIB_BOUNDARYPARSER_HPP
+#define PARSERLIB_BOUNDARYPARSER_HPP
+
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include "ParserNode.hpp"
+#include "ParserInterface.hpp"
+#include "ParserWrapper.hpp"
+#include "SequenceParser.hpp"
+#include "ChoiceParser.hpp"
+#include "Loop0Parser.hpp"
+#include "Loop1Parser.hpp"
+#include "OptionalParser.hpp"
+#include "AndParser.hpp"
+#include "NotParser.hpp"
+#include "MatchParser.hpp"
+#include "TreeMatchParser.hpp"
+#include "ParseContext.hpp"
+#include "FirstSet.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that invokes its child through a virtual call.
+     *
+     * The type of the parser depends only on the parse context type, and the code of the child is compiled
+     * once, in a function of its own, instead of being inlined into the code of the enclosing parsers.
+     * Placing boundaries in large grammars keeps the types of expressions short, at the cost of one indirect call
+     * per invocation of the child; the size of the code is reduced only if the type of the child is used in several places,
+     * since each boundary also adds a function of its own.
+     *
+     * Rules are also boundaries; a boundary is a rule without the support for recursion.
+     * @param ParseContextType type of parse context the child is invoked with.
+     */
+    template <class ParseContextType = ParseContext<>> class BoundaryParser : public ParserNode<BoundaryParser<ParseContextType>> {
+    public:
+        /**
+         * Constructor.
+         * Allocates a copy of the given parser on the heap.
+         * @param parser parser to copy.
+         */
+        template <class ParserNodeType>
+        BoundaryParser(const ParserNode<ParserNodeType>& parser)
+            : m_parser(std::make_shared<ParserWrapper<ParseContextType, ParserNodeType>>(static_cast<const ParserNodeType&>(parser)))
+        {
+        }
+
+        /**
+         * Returns the parser.
+         * @return the parser.
+         */
+        const std::shared_ptr<ParserInterface<ParseContextType>>& parser() const {
+            return m_parser;
+        }
+
+        /**
+         * Invokes the child.
+         * @param pc parse context.
+         * @return whatever the child returns.
+         */
+        bool operator ()(ParseContextType& pc) const {
+            return m_parser->operator()(pc);
+        }
+
+        /**
+         * Invokes the child as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return whatever the child returns.
+         */
+        bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return m_parser->parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        std::shared_ptr<ParserInterface<ParseContextType>> m_parser;
+    };
+
+
+    /**
+     * Puts a parser behind a boundary.
+     * @param parser the parser.
+     * @return a boundary parser.
+     */
+    template <class ParseContextType = ParseContext<>, class ParserNodeType>
+    BoundaryParser<ParseContextType> boundary(const ParserNode<ParserNodeType>& parser) {
+        return BoundaryParser<ParseContextType>(parser);
+    }
+
+
+    /**
+     * Number of parser nodes of an expression, up to the boundaries and rule references in it;
+     * it is the size of the code that the expression is inlined to.
+     * @param ParserNodeType type of parser node.
+     */
+    template <class ParserNodeType> struct ParserNodeCount : std::integral_constant<size_t, 1> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<const ParserNodeType> : ParserNodeCount<ParserNodeType> {
+    };
+
+
+    template <class ...Children> struct ParserNodeCount<SequenceParser<Children...>>
+        : std::integral_constant<size_t, (1 + ... + ParserNodeCount<Children>::value)> {
+    };
+
+
+    template <class ...Children> struct ParserNodeCount<ChoiceParser<Children...>>
+        : std::integral_constant<size_t, (1 + ... + ParserNodeCount<Children>::value)> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<Loop0Parser<ParserNodeType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<Loop1Parser<ParserNodeType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<OptionalParser<ParserNodeType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<AndParser<ParserNodeType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType> struct ParserNodeCount<NotParser<ParserNodeType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType, class MatchIdType> struct ParserNodeCount<MatchParser<ParserNodeType, MatchIdType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    template <class ParserNodeType, class MatchIdType> struct ParserNodeCount<TreeMatchParser<ParserNodeType, MatchIdType>>
+        : std::integral_constant<size_t, 1 + ParserNodeCount<ParserNodeType>::value> {
+    };
+
+
+    /**
+     * Places the boundaries of a parser that has no children; it returns the parser itself.
+     * @param parser the parser.
+     * @return the parser.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> ParserNodeType boundaries(const ParserNode<ParserNodeType>& parser) {
+        return static_cast<const ParserNodeType&>(parser);
+    }
+
+
+    //places the boundaries of a child, then puts the child behind a boundary if it is still larger than the given count
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaryChild(const ParserNodeType& parser) {
+        auto result = boundaries<ParseContextType, MaxNodeCount>(parser);
+        if constexpr (ParserNodeCount<decltype(result)>::value > MaxNodeCount) {
+            return BoundaryParser<ParseContextType>(result);
+        }
+        else {
+            return result;
+        }
+    }
+
+
+    /**
+     * Places the boundaries of the children of a sequence.
+     * @param parser the parser.
+     * @return a sequence of the children with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ...Children> auto boundaries(const SequenceParser<Children...>& parser) {
+        return std::apply([](const auto&... children) {
+            return SequenceParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(children))...>(std::make_tuple(boundaryChild<ParseContextType, MaxNodeCount>(children)...));
+        }, parser.children());
+    }
+
+
+    /**
+     * Places the boundaries of the children of a choice.
+     * @param parser the parser.
+     * @return a choice of the children with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ...Children> auto boundaries(const ChoiceParser<Children...>& parser) {
+        return std::apply([](const auto&... children) {
+            return ChoiceParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(children))...>(std::make_tuple(boundaryChild<ParseContextType, MaxNodeCount>(children)...));
+        }, parser.children());
+    }
+
+
+    /**
+     * Places the boundaries of the child of a loop.
+     * @param parser the parser.
+     * @return a loop of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaries(const Loop0Parser<ParserNodeType>& parser) {
+        return Loop0Parser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()))>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()));
+    }
+
+
+    /**
+     * Places the boundaries of the child of a loop.
+     * @param parser the parser.
+     * @return a loop of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaries(const Loop1Parser<ParserNodeType>& parser) {
+        return Loop1Parser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()))>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()));
+    }
+
+
+    /**
+     * Places the boundaries of the child of an optional.
+     * @param parser the parser.
+     * @return an optional of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaries(const OptionalParser<ParserNodeType>& parser) {
+        return OptionalParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()))>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()));
+    }
+
+
+    /**
+     * Places the boundaries of the child of a logical and.
+     * @param parser the parser.
+     * @return a logical and of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaries(const AndParser<ParserNodeType>& parser) {
+        return AndParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()))>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()));
+    }
+
+
+    /**
+     * Places the boundaries of the child of a logical not.
+     * @param parser the parser.
+     * @return a logical not of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType> auto boundaries(const NotParser<ParserNodeType>& parser) {
+        return NotParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()))>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()));
+    }
+
+
+    /**
+     * Places the boundaries of the child of a match parser.
+     * @param parser the parser.
+     * @return a match parser of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType, class MatchIdType> auto boundaries(const MatchParser<ParserNodeType, MatchIdType>& parser) {
+        return MatchParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child())), MatchIdType>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * Places the boundaries of the child of a tree match parser.
+     * @param parser the parser.
+     * @return a tree match parser of the child with boundaries.
+     */
+    template <class ParseContextType, size_t MaxNodeCount, class ParserNodeType, class MatchIdType> auto boundaries(const TreeMatchParser<ParserNodeType, MatchIdType>& parser) {
+        return TreeMatchParser<decltype(boundaryChild<ParseContextType, MaxNodeCount>(parser.child())), MatchIdType>(boundaryChild<ParseContextType, MaxNodeCount>(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * Places boundaries in an expression, so as that no part of it larger than the given number of nodes is inlined:
+     * the subexpressions that are larger than that, after the boundaries within them are placed, are put behind boundaries.
+     * The result parses the same as the given expression.
+     * @param parser the parser.
+     * @return the parser with boundaries.
+     */
+    template <class ParseContextType = ParseContext<>, size_t MaxNodeCount = 16, class ParserNodeType> auto bounded(const ParserNode<ParserNodeType>& parser) {
+        return boundaries<ParseContextType, MaxNodeCount>(static_cast<const ParserNodeType&>(parser));
+    }
+
+
+    /**
+     * Computes the first set of a boundary.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParseContextType> FirstSet computeFirstSet(const BoundaryParser<ParseContextType>& parser, FirstSetContext& context) {
+        return parser.parser()->firstSet(context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_BOUNDARYPARSER_HPP
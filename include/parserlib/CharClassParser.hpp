@@ -0,0 +1,691 @@
+#ifndef PARSERLIB_CHARCLASSPARSER_HPP
+#define PARSERLIB_CHARCLASSPARSER_HPP
+
+
+#include <array>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "ParserNode.hpp"
+#include "TerminalParser.hpp"
+#include "TerminalRangeParser.hpp"
+#include "TerminalSetParser.hpp"
+#include "SequenceParser.hpp"
+#include "ChoiceParser.hpp"
+#include "Loop0Parser.hpp"
+#include "Loop1Parser.hpp"
+#include "LoopNParser.hpp"
+#include "OptionalParser.hpp"
+#include "AndParser.hpp"
+#include "NotParser.hpp"
+#include "MatchParser.hpp"
+#include "TreeMatchParser.hpp"
+#include "ParseContext.hpp"
+#include "FirstSet.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * Trait that checks if a parser parses exactly one character out of a set of characters,
+     * i.e. if it is a character terminal, a character set, a character range, or a choice of those.
+     * @param T parser type.
+     */
+    template <class T> struct IsCharClass : std::false_type {
+    };
+
+
+    template <> struct IsCharClass<TerminalParser<char>> : std::true_type {
+    };
+
+
+    template <> struct IsCharClass<TerminalSetParser<char>> : std::true_type {
+    };
+
+
+    template <> struct IsCharClass<TerminalRangeParser<char>> : std::true_type {
+    };
+
+
+    template <class ...Children> struct IsCharClass<ChoiceParser<Children...>> : std::bool_constant<(IsCharClass<Children>::value && ...)> {
+    };
+
+
+    /**
+     * Trait that checks if a parser parses a fixed number of characters, each one out of a set of characters,
+     * i.e. if it is a character class, a loop of a fixed count over a character class, or a sequence of those.
+     * @param T parser type.
+     */
+    template <class T> struct IsFixedWidthCharPattern : IsCharClass<T> {
+    };
+
+
+    template <class ParserNodeType> struct IsFixedWidthCharPattern<LoopNParser<ParserNodeType>> : IsCharClass<ParserNodeType> {
+    };
+
+
+    template <class ...Children> struct IsFixedWidthCharPattern<SequenceParser<Children...>> : std::bool_constant<(IsFixedWidthCharPattern<Children>::value && ...)> {
+    };
+
+
+    /**
+     * The characters a character class parser accepts, as lookup tables for case-sensitive and case-insensitive sources.
+     *
+     * The tables are computed by invoking the parser on each character value, and therefore
+     * they accept exactly the characters the parser accepts.
+     */
+    class CharClassTable {
+    public:
+        /**
+         * Constructor.
+         * @param parser the character class parser.
+         */
+        template <class ParserNodeType> CharClassTable(const ParserNodeType& parser)
+            : m_caseSensitive(makeTable<true>(parser)), m_caseInsensitive(makeTable<false>(parser))
+        {
+        }
+
+        /**
+         * Checks if a character is accepted.
+         * @param value the character.
+         * @return true if the character is accepted, false otherwise.
+         */
+        template <bool CaseSensitive> bool contains(char value) const {
+            return (CaseSensitive ? m_caseSensitive : m_caseInsensitive)[static_cast<unsigned char>(value)] != 0;
+        }
+
+        /**
+         * Returns the table.
+         * @return the table; the value of a character is non-zero if the character is accepted.
+         */
+        template <bool CaseSensitive> const std::array<unsigned char, 256>& table() const {
+            return CaseSensitive ? m_caseSensitive : m_caseInsensitive;
+        }
+
+    private:
+        const std::array<unsigned char, 256> m_caseSensitive;
+        const std::array<unsigned char, 256> m_caseInsensitive;
+
+        template <bool CaseSensitive, class ParserNodeType> static std::array<unsigned char, 256> makeTable(const ParserNodeType& parser) {
+            using ProbeContext = ParseContext<std::string, int, SourcePosition<std::string, CaseSensitive>>;
+            std::array<unsigned char, 256> result{};
+            for (size_t value = 0; value < result.size(); ++value) {
+                const std::string source(1, static_cast<char>(value));
+                ProbeContext pc(source);
+                result[value] = parser(pc) && pc.sourceEnded();
+            }
+            return result;
+        }
+    };
+
+
+    /**
+     * Checks if a parse context can use the tables of character class parsers, i.e. if its source is made of 'char'.
+     * @param ParseContextType type of parse context.
+     * @return true if the tables can be used, false otherwise.
+     */
+    template <class ParseContextType> constexpr bool canUseCharClassTable() {
+        using Iterator = SourceIterator<typename ParseContextType::SourceType>;
+        return std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>, char>;
+    }
+
+
+    /**
+     * A character class parser compiled to a lookup table.
+     *
+     * A character is accepted by one table lookup, instead of a comparison per character, range or alternative.
+     * When the character is not accepted, the original parser is invoked, so as that the errors are the same as its own.
+     * Sources that are not made of 'char' are parsed by the original parser.
+     * @param ParserNodeType type of the original parser.
+     */
+    template <class ParserNodeType> class CharClassParser : public ParserNode<CharClassParser<ParserNodeType>> {
+    public:
+        /**
+         * Constructor.
+         * @param parser the original parser.
+         */
+        CharClassParser(const ParserNodeType& parser) : m_parser(parser), m_table(std::make_shared<const CharClassTable>(parser)) {
+        }
+
+        /**
+         * Returns the original parser.
+         * @return the original parser.
+         */
+        const ParserNodeType& parser() const {
+            return m_parser;
+        }
+
+        /**
+         * Returns the table.
+         * @return the table.
+         */
+        const CharClassTable& table() const {
+            return *m_table;
+        }
+
+        /**
+         * Parses a character of the class.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            if constexpr (canUseCharClassTable<ParseContextType>()) {
+                return pc.parseAfterSkip([&]() {
+                    if (sourcePositionContainsClass(pc)) {
+                        pc.incrementSourcePosition();
+                        return true;
+                    }
+                    return m_parser(pc);
+                    });
+            }
+            else {
+                return m_parser(pc);
+            }
+        }
+
+        /**
+         * Checks if a character of the class is at the current position, without consuming it and without adding an error.
+         * @param pc parse context.
+         * @return true if a character of the class is at the current position, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            if constexpr (canUseCharClassTable<ParseContextType>()) {
+                return pc.peek([&]() { return sourcePositionContainsClass(pc); });
+            }
+            else {
+                return pc.peek([&]() {
+                    const auto state = pc.state();
+                    const auto errorState = pc.errorState();
+                    const bool result = m_parser(pc);
+                    pc.setState(state);
+                    pc.setErrorState(errorState);
+                    return result;
+                });
+            }
+        }
+
+        /**
+         * Invokes the original parser as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return the result of the original parser.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return m_parser.parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        const ParserNodeType m_parser;
+        std::shared_ptr<const CharClassTable> m_table;
+
+        template <class ParseContextType> bool sourcePositionContainsClass(const ParseContextType& pc) const {
+            return !pc.sourceEnded() && m_table->contains<IsCaseSensitivePosition<typename ParseContextType::PositionType>::value>(*pc.sourcePosition().iterator());
+        }
+    };
+
+
+    /**
+     * A loop over a character class compiled to a scanning loop over a lookup table.
+     *
+     * Without a skipper, the characters of the class are scanned by a loop over the table,
+     * in contiguous blocks if the source allows it, and the source position is increased once.
+     * If fewer than the min number of characters are found, or if there is a skipper, the original loop is invoked,
+     * so as that the result and the errors are the same as its own.
+     * @param LoopType type of the original loop.
+     * @param ParserNodeType type of the character class parser.
+     * @param MinCount min number of characters.
+     */
+    template <class LoopType, class ParserNodeType, size_t MinCount> class CharClassLoopParser : public ParserNode<CharClassLoopParser<LoopType, ParserNodeType, MinCount>> {
+    public:
+        /**
+         * Constructor.
+         * @param loop the original loop.
+         */
+        CharClassLoopParser(const LoopType& loop) : m_loop(loop), m_table(std::make_shared<const CharClassTable>(loop.child())) {
+        }
+
+        /**
+         * Returns the original loop.
+         * @return the original loop.
+         */
+        const LoopType& loop() const {
+            return m_loop;
+        }
+
+        /**
+         * Parses characters of the class, as many as possible.
+         * @param pc parse context.
+         * @return true if at least the min number of characters is parsed, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            if constexpr (canUseCharClassTable<ParseContextType>()) {
+                if (!pc.skipper()) {
+                    const auto& table = m_table->table<IsCaseSensitivePosition<typename ParseContextType::PositionType>::value>();
+                    const auto begin = pc.sourcePosition().iterator();
+                    auto it = begin;
+                    using Iterator = std::remove_cv_t<decltype(it)>;
+                    if constexpr (hasContiguousSegments<Iterator>()) {
+                        it = scanSegments(it, pc.sourceEnd(), [&](const char* data, const char* end) {
+                            for (; data != end && table[static_cast<unsigned char>(*data)]; ++data) {
+                            }
+                            return data;
+                        });
+                    }
+                    else {
+                        for (const auto end = pc.sourceEnd(); it != end && table[static_cast<unsigned char>(*it)]; ++it) {
+                        }
+                    }
+                    const auto count = static_cast<size_t>(std::distance(begin, it));
+                    if (count >= MinCount) {
+                        pc.increaseSourcePosition(count);
+                        return true;
+                    }
+                }
+            }
+            return m_loop(pc);
+        }
+
+        /**
+         * Invokes the original loop as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return the result of the original loop.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return m_loop.parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        const LoopType m_loop;
+        std::shared_ptr<const CharClassTable> m_table;
+    };
+
+
+    /**
+     * The character classes of a fixed-width pattern, one per character, as lookup tables.
+     *
+     * If each class is a range of characters and the pattern has at most 16 characters,
+     * the pattern is also kept as per-character bounds, so as that a 16-byte window is checked by SSE2 comparisons.
+     */
+    class FixedWidthCharTable {
+    public:
+        /**
+         * Max number of characters of a pattern that can be checked by SSE2 comparisons.
+         */
+        static constexpr size_t MaxVectorWidth = 16;
+
+        /**
+         * Constructor.
+         * @param parser the fixed-width pattern parser.
+         */
+        template <class ParserNodeType> FixedWidthCharTable(const ParserNodeType& parser) {
+            addClasses(parser);
+            makeBounds<true>(m_caseSensitiveBounds);
+            makeBounds<false>(m_caseInsensitiveBounds);
+        }
+
+        /**
+         * Returns the number of characters of the pattern.
+         * @return the number of characters of the pattern.
+         */
+        size_t size() const {
+            return m_classes.size();
+        }
+
+        /**
+         * Checks if the characters at the given position match the pattern.
+         * @param it position of the first character.
+         * @param end end of source.
+         * @return true if the pattern matches, false otherwise.
+         */
+        template <bool CaseSensitive, class Iterator> bool matches(Iterator it, const Iterator& end) const {
+            const size_t count = m_classes.size();
+            if constexpr (isContiguousIterator<Iterator>()) {
+                const size_t available = static_cast<size_t>(end - it);
+                if (available < count) {
+                    return false;
+                }
+                const char* const data = toPointer(it);
+                #ifdef PARSERLIB_SSE2
+                const Bounds& bounds = CaseSensitive ? m_caseSensitiveBounds : m_caseInsensitiveBounds;
+                if (bounds.valid && available >= MaxVectorWidth) {
+                    //signed comparisons of biased bytes are unsigned comparisons of bytes
+                    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+                    const __m128i chunk = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), bias);
+                    const __m128i below = _mm_cmplt_epi8(chunk, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.min)));
+                    const __m128i above = _mm_cmpgt_epi8(chunk, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.max)));
+                    const unsigned mismatches = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(below, above)));
+                    return (mismatches & ((1u << count) - 1)) == 0;
+                }
+                #endif
+                for (size_t index = 0; index < count; ++index) {
+                    if (!m_classes[index]->contains<CaseSensitive>(data[index])) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            else {
+                for (size_t index = 0; index < count; ++index, ++it) {
+                    if (it == end || !m_classes[index]->contains<CaseSensitive>(*it)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+    private:
+        struct Bounds {
+            bool valid{ false };
+            char min[MaxVectorWidth];
+            char max[MaxVectorWidth];
+        };
+
+        std::vector<std::shared_ptr<const CharClassTable>> m_classes;
+        Bounds m_caseSensitiveBounds;
+        Bounds m_caseInsensitiveBounds;
+
+        template <class ParserNodeType> void addClasses(const ParserNodeType& parser) {
+            m_classes.push_back(std::make_shared<const CharClassTable>(parser));
+        }
+
+        template <class ParserNodeType> void addClasses(const LoopNParser<ParserNodeType>& parser) {
+            m_classes.insert(m_classes.end(), parser.loopCount(), std::make_shared<const CharClassTable>(parser.child()));
+        }
+
+        template <class ...Children> void addClasses(const SequenceParser<Children...>& parser) {
+            std::apply([&](const auto&... children) { (addClasses(children), ...); }, parser.children());
+        }
+
+        //the bounds are valid if each class is one range of characters; positions after the pattern accept any character
+        template <bool CaseSensitive> void makeBounds(Bounds& bounds) const {
+            if (m_classes.size() > MaxVectorWidth) {
+                return;
+            }
+            for (size_t index = 0; index < MaxVectorWidth; ++index) {
+                size_t min = 0;
+                size_t max = 255;
+                if (index < m_classes.size()) {
+                    const auto& table = m_classes[index]->table<CaseSensitive>();
+                    for (min = 0; min < 256 && !table[min]; ++min) {
+                    }
+                    if (min == 256) {
+                        return;
+                    }
+                    for (max = 255; !table[max]; --max) {
+                    }
+                    for (size_t value = min; value <= max; ++value) {
+                        if (!table[value]) {
+                            return;
+                        }
+                    }
+                }
+                bounds.min[index] = static_cast<char>(min ^ 0x80);
+                bounds.max[index] = static_cast<char>(max ^ 0x80);
+            }
+            bounds.valid = true;
+        }
+    };
+
+
+    /**
+     * A fixed-width pattern of character classes, e.g. a loop of a fixed count over a character class,
+     * or a sequence of character classes, such as a date, compiled to a single check of all its characters.
+     *
+     * Without a skipper, all the characters are checked at once, and the source position is increased once,
+     * instead of one step and one state checkpoint per character.
+     * If the characters do not match, or if there is a skipper, the original parser is invoked,
+     * so as that the result and the errors are the same as its own.
+     * @param ParserNodeType type of the original parser.
+     */
+    template <class ParserNodeType> class FixedWidthCharParser : public ParserNode<FixedWidthCharParser<ParserNodeType>> {
+    public:
+        /**
+         * Constructor.
+         * @param parser the original parser.
+         */
+        FixedWidthCharParser(const ParserNodeType& parser) : m_parser(parser), m_table(std::make_shared<const FixedWidthCharTable>(parser)) {
+        }
+
+        /**
+         * Returns the original parser.
+         * @return the original parser.
+         */
+        const ParserNodeType& parser() const {
+            return m_parser;
+        }
+
+        /**
+         * Returns the table.
+         * @return the table.
+         */
+        const FixedWidthCharTable& table() const {
+            return *m_table;
+        }
+
+        /**
+         * Parses the characters of the pattern.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            if constexpr (canUseCharClassTable<ParseContextType>()) {
+                if (!pc.skipper() && m_table->matches<IsCaseSensitivePosition<typename ParseContextType::PositionType>::value>(pc.sourcePosition().iterator(), pc.sourceEnd())) {
+                    pc.increaseSourcePosition(m_table->size());
+                    return true;
+                }
+            }
+            return m_parser(pc);
+        }
+
+        /**
+         * Invokes the original parser as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return the result of the original parser.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return m_parser.parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        const ParserNodeType m_parser;
+        std::shared_ptr<const FixedWidthCharTable> m_table;
+    };
+
+
+    /**
+     * Compiles a parser that has no character classes; it returns the parser itself.
+     * @param parser the parser.
+     * @return the parser.
+     */
+    template <class ParserNodeType> ParserNodeType compile(const ParserNode<ParserNodeType>& parser) {
+        return static_cast<const ParserNodeType&>(parser);
+    }
+
+
+    /**
+     * Compiles a character set to a lookup table.
+     * @param parser the parser.
+     * @return a character class parser.
+     */
+    inline CharClassParser<TerminalSetParser<char>> compile(const TerminalSetParser<char>& parser) {
+        return CharClassParser<TerminalSetParser<char>>(parser);
+    }
+
+
+    /**
+     * Compiles a sequence; a sequence of character classes and of fixed-count loops over character classes
+     * is compiled to a fixed-width pattern.
+     * @param parser the parser.
+     * @return a fixed-width pattern parser or a sequence of compiled children.
+     */
+    template <class ...Children> auto compile(const SequenceParser<Children...>& parser) {
+        if constexpr (IsFixedWidthCharPattern<SequenceParser<Children...>>::value) {
+            return FixedWidthCharParser<SequenceParser<Children...>>(parser);
+        }
+        else {
+            return std::apply([](const auto&... children) {
+                return SequenceParser<decltype(compile(children))...>(std::make_tuple(compile(children)...));
+            }, parser.children());
+        }
+    }
+
+
+    /**
+     * Compiles a choice; a choice of character classes is compiled to a lookup table.
+     * @param parser the parser.
+     * @return a character class parser or a choice of compiled children.
+     */
+    template <class ...Children> auto compile(const ChoiceParser<Children...>& parser) {
+        if constexpr (IsCharClass<ChoiceParser<Children...>>::value) {
+            return CharClassParser<ChoiceParser<Children...>>(parser);
+        }
+        else {
+            return std::apply([](const auto&... children) {
+                return ChoiceParser<decltype(compile(children))...>(std::make_tuple(compile(children)...));
+            }, parser.children());
+        }
+    }
+
+
+    /**
+     * Compiles a loop; a loop over a character class is compiled to a scanning loop.
+     * @param parser the parser.
+     * @return a character class loop or a loop over the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const Loop0Parser<ParserNodeType>& parser) {
+        if constexpr (IsCharClass<ParserNodeType>::value) {
+            return CharClassLoopParser<Loop0Parser<ParserNodeType>, ParserNodeType, 0>(parser);
+        }
+        else {
+            return Loop0Parser<decltype(compile(parser.child()))>(compile(parser.child()));
+        }
+    }
+
+
+    /**
+     * Compiles a loop; a loop over a character class is compiled to a scanning loop.
+     * @param parser the parser.
+     * @return a character class loop or a loop over the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const Loop1Parser<ParserNodeType>& parser) {
+        if constexpr (IsCharClass<ParserNodeType>::value) {
+            return CharClassLoopParser<Loop1Parser<ParserNodeType>, ParserNodeType, 1>(parser);
+        }
+        else {
+            return Loop1Parser<decltype(compile(parser.child()))>(compile(parser.child()));
+        }
+    }
+
+
+    /**
+     * Compiles a loop of a fixed count; a loop over a character class is compiled to a fixed-width pattern.
+     * @param parser the parser.
+     * @return a fixed-width pattern parser or a loop over the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const LoopNParser<ParserNodeType>& parser) {
+        if constexpr (IsCharClass<ParserNodeType>::value) {
+            return FixedWidthCharParser<LoopNParser<ParserNodeType>>(parser);
+        }
+        else {
+            return LoopNParser<decltype(compile(parser.child()))>(parser.loopCount(), compile(parser.child()));
+        }
+    }
+
+
+    /**
+     * Compiles the child of an optional.
+     * @param parser the parser.
+     * @return an optional of the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const OptionalParser<ParserNodeType>& parser) {
+        return OptionalParser<decltype(compile(parser.child()))>(compile(parser.child()));
+    }
+
+
+    /**
+     * Compiles the child of a logical AND parser.
+     * @param parser the parser.
+     * @return a logical AND parser of the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const AndParser<ParserNodeType>& parser) {
+        return AndParser<decltype(compile(parser.child()))>(compile(parser.child()));
+    }
+
+
+    /**
+     * Compiles the child of a logical NOT parser.
+     * @param parser the parser.
+     * @return a logical NOT parser of the compiled child.
+     */
+    template <class ParserNodeType> auto compile(const NotParser<ParserNodeType>& parser) {
+        return NotParser<decltype(compile(parser.child()))>(compile(parser.child()));
+    }
+
+
+    /**
+     * Compiles the child of a match parser.
+     * @param parser the parser.
+     * @return a match parser of the compiled child.
+     */
+    template <class ParserNodeType, class MatchIdType> auto compile(const MatchParser<ParserNodeType, MatchIdType>& parser) {
+        return MatchParser<decltype(compile(parser.child())), MatchIdType>(compile(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * Compiles the child of a tree match parser.
+     * @param parser the parser.
+     * @return a tree match parser of the compiled child.
+     */
+    template <class ParserNodeType, class MatchIdType> auto compile(const TreeMatchParser<ParserNodeType, MatchIdType>& parser) {
+        return TreeMatchParser<decltype(compile(parser.child())), MatchIdType>(compile(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * Computes the first set of a character class parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the original parser.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const CharClassParser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.parser(), context);
+    }
+
+
+    /**
+     * Computes the first set of a fixed-width pattern parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the original parser.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const FixedWidthCharParser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.parser(), context);
+    }
+
+
+    /**
+     * Computes the first set of a character class loop.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the original loop.
+     */
+    template <class LoopType, class ParserNodeType, size_t MinCount>
+    FirstSet computeFirstSet(const CharClassLoopParser<LoopType, ParserNodeType, MinCount>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.loop(), context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_CHARCLASSPARSER_HPP
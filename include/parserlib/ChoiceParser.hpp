@@ -2,6 +2,7 @@
 #define PARSERLIB_CHOICEPARSER_HPP
 
 
+#include <tuple>
 #include <type_traits>
 #include "ParserNode.hpp"
 #include "TerminalParser.hpp"
@@ -48,6 +49,17 @@ namespace parserlib {
             return false;
         }
 
+        /**
+         * Checks if any of the children parsers is at the current position, without changing the parse context;
+         * available only if all children can peek.
+         * @param pc parse context.
+         * @return true if a child parser is at the current position, false otherwise.
+         */
+        template <class ParseContextType>
+        auto peek(ParseContextType& pc) const -> std::enable_if_t<(CanPeek<Children, ParseContextType>::value && ...), bool> {
+            return std::apply([&](const auto&... children) { return (children.peek(pc) || ...); }, m_children);
+        }
+
         /**
          * Invokes all child parsers, one by one, until one returns true.
          * The object is called to parse within a left recursion parsing context,
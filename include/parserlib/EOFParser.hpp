@@ -15,11 +15,23 @@ namespace parserlib {
     public:
         /**
          * Checks if the source has ended.
+         * If the parse context has a skipper, then whitespace and comments are skipped before the check.
          * @param pc parse context.
          * @return true if there is no more input to parse, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            return pc.sourceEnded();
+            return pc.parseAfterSkip([&]() {
+                return pc.sourceEnded();
+                });
+        }
+
+        /**
+         * Checks if the source has ended, without consuming whitespace and comments.
+         * @param pc parse context.
+         * @return true if there is no more input to parse, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            return pc.peek([&]() { return pc.sourceEnded(); });
         }
 
         /**
@@ -0,0 +1,716 @@
+#ifndef PARSERLIB_FIRSTSET_HPP
+#define PARSERLIB_FIRSTSET_HPP
+
+
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include "ParserNode.hpp"
+#include "TerminalParser.hpp"
+#include "TerminalStringParser.hpp"
+#include "TerminalRangeParser.hpp"
+#include "TerminalSetParser.hpp"
+#include "EOFParser.hpp"
+#include "EmptyParser.hpp"
+#include "SequenceParser.hpp"
+#include "ChoiceParser.hpp"
+#include "Loop0Parser.hpp"
+#include "Loop1Parser.hpp"
+#include "LoopNParser.hpp"
+#include "ListParser.hpp"
+#include "OptionalParser.hpp"
+#include "AndParser.hpp"
+#include "NotParser.hpp"
+#include "MatchParser.hpp"
+#include "TreeMatchParser.hpp"
+#include "ValueMatchParser.hpp"
+#include "NumberParser.hpp"
+#include "SkipParser.hpp"
+#include "RuleReference.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    template <class ParseContextType> class Rule;
+
+
+    /**
+     * The set of byte values a parser can start with, plus a flag that indicates
+     * if the parser can succeed without consuming any input (i.e. if it is nullable).
+     *
+     * First sets are conservative: they may contain values that can never start a match,
+     * but they never miss a value that can; a parser that cannot be analyzed yields a full, nullable set.
+     * Values outside of the byte range make the set full.
+     */
+    class FirstSet {
+    public:
+        /**
+         * The default constructor.
+         * The set is empty and not nullable.
+         */
+        FirstSet() {
+        }
+
+        /**
+         * Returns a full, nullable set; used for parsers that cannot be analyzed.
+         * @return a full, nullable set.
+         */
+        static FirstSet all() {
+            FirstSet result;
+            result.m_bits.set();
+            result.m_nullable = true;
+            return result;
+        }
+
+        /**
+         * Returns the bits of the set; bit i is set if the byte value i is contained in the set.
+         * @return the bits of the set.
+         */
+        const std::bitset<256>& bits() const {
+            return m_bits;
+        }
+
+        /**
+         * Checks if the given byte value is contained in the set.
+         * @param value byte value.
+         * @return true if the value is contained in the set, false otherwise.
+         */
+        bool contains(unsigned char value) const {
+            return m_bits[value];
+        }
+
+        /**
+         * Returns the number of byte values in the set.
+         * @return the number of byte values in the set.
+         */
+        size_t size() const {
+            return m_bits.count();
+        }
+
+        /**
+         * Checks if the set contains all the byte values.
+         * @return true if the set is full, false otherwise.
+         */
+        bool isAll() const {
+            return m_bits.all();
+        }
+
+        /**
+         * Checks if the set contains the given value, taking into account
+         * values that do not fit in a byte.
+         * @param value value.
+         * @return true if the value is contained in the set, false otherwise.
+         */
+        template <class T> bool containsValue(const T& value) const {
+            if constexpr (sizeof(T) == 1) {
+                return m_bits[static_cast<unsigned char>(value)];
+            }
+            else {
+                return isAll() || (isByteValue(value) && m_bits[static_cast<unsigned char>(value)]);
+            }
+        }
+
+        /**
+         * Checks if the set intersects with another set.
+         * @param other the other set.
+         * @return true if there is at least one common byte value, false otherwise.
+         */
+        bool intersects(const FirstSet& other) const {
+            return (m_bits & other.m_bits).any();
+        }
+
+        /**
+         * Checks if the parser can succeed without consuming input.
+         * @return true if the parser can succeed without consuming input, false otherwise.
+         */
+        bool nullable() const {
+            return m_nullable;
+        }
+
+        /**
+         * Sets the nullable flag.
+         * @param nullable if true, the parser can succeed without consuming input.
+         */
+        void setNullable(bool nullable) {
+            m_nullable = nullable;
+        }
+
+        /**
+         * Adds a value to the set.
+         * @param value value to add; if it does not fit in a byte, then the set becomes full.
+         * @param caseSensitive if false, all byte values that are equal to the given value when lowercased are added.
+         */
+        template <class T> void add(const T& value, bool caseSensitive = true) {
+            addRange(value, value, caseSensitive);
+        }
+
+        /**
+         * Adds a range of values to the set.
+         * @param minValue min value.
+         * @param maxValue max value.
+         * @param caseSensitive if false, all byte values that are within the range when lowercased are added,
+         *  following the comparison rules of a case insensitive source position.
+         */
+        template <class T> void addRange(const T& minValue, const T& maxValue, bool caseSensitive = true) {
+            if (!isByteValue(minValue) || !isByteValue(maxValue)) {
+                m_bits.set();
+                return;
+            }
+            const int minByte = static_cast<unsigned char>(minValue);
+            const int maxByte = static_cast<unsigned char>(maxValue);
+            if (caseSensitive) {
+                for (int value = minByte; value <= maxByte; ++value) {
+                    m_bits.set(static_cast<size_t>(value));
+                }
+            }
+            else {
+                const int lowerMin = std::tolower(minByte);
+                const int lowerMax = std::tolower(maxByte);
+                for (int value = 0; value < 256; ++value) {
+                    const int lowerValue = std::tolower(value);
+                    if (lowerValue >= lowerMin && lowerValue <= lowerMax) {
+                        m_bits.set(static_cast<size_t>(value));
+                    }
+                }
+            }
+        }
+
+        /**
+         * Adds the byte values of another set; the nullable flag is not modified.
+         * @param other the other set.
+         */
+        void addValues(const FirstSet& other) {
+            m_bits |= other.m_bits;
+        }
+
+        /**
+         * Adds the byte values a skipper can start skipping at.
+         * @param skipper the skipper.
+         */
+        void addSkipper(const Skipper& skipper) {
+            for (const char c : skipper.whitespace()) {
+                add(c);
+            }
+            if (!skipper.lineCommentStart().empty()) {
+                add(skipper.lineCommentStart()[0]);
+            }
+            if (!skipper.blockCommentStart().empty()) {
+                add(skipper.blockCommentStart()[0]);
+            }
+        }
+
+        /**
+         * Finds the first element of a range that is contained in the set.
+         * For contiguous or segmented byte sources, a single-value set is searched with memchr,
+         * and small sets are searched 16 bytes at a time (SSE2).
+         * @param it start of range.
+         * @param end end of range.
+         * @return iterator to the first element contained in the set, or end if there is none.
+         */
+        template <class Iterator> Iterator find(Iterator it, const Iterator& end) const {
+            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+            if constexpr (hasContiguousSegments<Iterator>() && sizeof(ValueType) == 1) {
+                return scanSegments(it, end, [&](const ValueType* begin, const ValueType* segmentEnd) {
+                    return findInBlock(begin, segmentEnd);
+                });
+            }
+            else {
+                for (; it != end && !containsValue(*it); ++it) {
+                }
+                return it;
+            }
+        }
+
+    private:
+        std::bitset<256> m_bits;
+        bool m_nullable{ false };
+
+        template <class T> static bool isByteValue(const T& value) {
+            if constexpr (sizeof(T) == 1) {
+                return true;
+            }
+            else {
+                return value >= 0 && value < 256;
+            }
+        }
+
+        template <class T> const T* findInBlock(const T* it, const T* end) const {
+            const size_t count = size();
+
+            if (count == 1) {
+                const void* found = std::memchr(it, static_cast<int>(firstValue()), static_cast<size_t>(end - it));
+                return found ? static_cast<const T*>(found) : end;
+            }
+
+            #ifdef PARSERLIB_SSE2
+            if (count > 1 && count <= 16) {
+                __m128i values[16];
+                size_t valueCount = 0;
+                for (size_t value = 0; value < 256; ++value) {
+                    if (m_bits[value]) {
+                        values[valueCount++] = _mm_set1_epi8(static_cast<char>(value));
+                    }
+                }
+                while (end - it >= 16) {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                    __m128i mask = _mm_setzero_si128();
+                    for (size_t index = 0; index < valueCount; ++index) {
+                        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, values[index]));
+                    }
+                    const unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(mask));
+                    if (bits) {
+                        return it + countTrailingZeros(bits);
+                    }
+                    it += 16;
+                }
+            }
+            #endif
+
+            for (; it != end && !m_bits[static_cast<unsigned char>(*it)]; ++it) {
+            }
+            return it;
+        }
+
+        unsigned char firstValue() const {
+            for (size_t value = 0; value < 256; ++value) {
+                if (m_bits[value]) {
+                    return static_cast<unsigned char>(value);
+                }
+            }
+            return 0;
+        }
+    };
+
+
+    /**
+     * State of a first set computation.
+     * It keeps the rules under analysis, so as that recursive rules are not analyzed endlessly.
+     */
+    class FirstSetContext {
+    public:
+        /**
+         * Constructor.
+         * @param caseSensitive if false, values are added to first sets case insensitively.
+         */
+        FirstSetContext(bool caseSensitive = true) : m_caseSensitive(caseSensitive) {
+        }
+
+        /**
+         * Returns the case sensitivity flag.
+         * @return the case sensitivity flag.
+         */
+        bool caseSensitive() const {
+            return m_caseSensitive;
+        }
+
+        /**
+         * Marks a rule as being under analysis.
+         * @param rule rule.
+         * @return true if the rule was not under analysis, false if the rule is recursive.
+         */
+        bool enterRule(const void* rule) {
+            return m_rules.insert(rule).second;
+        }
+
+        /**
+         * Marks a rule as not being under analysis.
+         * @param rule rule.
+         */
+        void leaveRule(const void* rule) {
+            m_rules.erase(rule);
+        }
+
+    private:
+        const bool m_caseSensitive;
+        std::set<const void*> m_rules;
+    };
+
+
+    /**
+     * Computes the first set of a parser that cannot be analyzed.
+     * @param parser the parser.
+     * @param context the context.
+     * @return a full, nullable set.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const ParserNode<ParserNodeType>& /*parser*/, FirstSetContext& /*context*/) {
+        return FirstSet::all();
+    }
+
+
+    /**
+     * Computes the first set of a terminal parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class T> FirstSet computeFirstSet(const TerminalParser<T>& parser, FirstSetContext& context) {
+        FirstSet result;
+        result.add(parser.terminalValue(), context.caseSensitive());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a terminal string parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set; nullable if the string is empty.
+     */
+    template <class T> FirstSet computeFirstSet(const TerminalStringParser<T>& parser, FirstSetContext& context) {
+        FirstSet result;
+        if (parser.string()[0] == 0) {
+            result.setNullable(true);
+        }
+        else {
+            result.add(parser.string()[0], context.caseSensitive());
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a terminal range parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class T> FirstSet computeFirstSet(const TerminalRangeParser<T>& parser, FirstSetContext& context) {
+        FirstSet result;
+        result.addRange(parser.minTerminalValue(), parser.maxTerminalValue(), context.caseSensitive());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a terminal set parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class T> FirstSet computeFirstSet(const TerminalSetParser<T>& parser, FirstSetContext& context) {
+        FirstSet result;
+        for (const auto& value : parser.terminalValues()) {
+            result.add(value, context.caseSensitive());
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of the end-of-file parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return an empty, nullable set.
+     */
+    inline FirstSet computeFirstSet(const EOFParser& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of the empty parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return an empty, nullable set.
+     */
+    inline FirstSet computeFirstSet(const EmptyParser& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a sequence: the union of the first sets of its children,
+     * up to and including the first child that is not nullable.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class ...Children> FirstSet computeFirstSet(const SequenceParser<Children...>& parser, FirstSetContext& context) {
+        FirstSet result;
+        result.setNullable(true);
+        std::apply([&](const auto&... children) {
+            ([&](const auto& child) {
+                if (result.nullable()) {
+                    const FirstSet childSet = computeFirstSet(child, context);
+                    result.addValues(childSet);
+                    result.setNullable(childSet.nullable());
+                }
+            }(children), ...);
+        }, parser.children());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a choice: the union of the first sets of its children.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class ...Children> FirstSet computeFirstSet(const ChoiceParser<Children...>& parser, FirstSetContext& context) {
+        FirstSet result;
+        std::apply([&](const auto&... children) {
+            ([&](const auto& child) {
+                const FirstSet childSet = computeFirstSet(child, context);
+                result.addValues(childSet);
+                result.setNullable(result.nullable() || childSet.nullable());
+            }(children), ...);
+        }, parser.children());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a loop that may parse its child zero times.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child, nullable.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const Loop0Parser<ParserNodeType>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.child(), context);
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a loop that parses its child at least once.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const Loop1Parser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+    /**
+     * Computes the first set of a loop that parses its child a specific number of times.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child; nullable if the loop count is 0.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const LoopNParser<ParserNodeType>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.child(), context);
+        if (parser.loopCount() == 0) {
+            result.setNullable(true);
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a list parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the item; nullable if the min count is 0.
+     */
+    template <class ItemType, class SeparatorType> FirstSet computeFirstSet(const ListParser<ItemType, SeparatorType>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.item(), context);
+        if (parser.minCount() == 0) {
+            result.setNullable(true);
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of an optional parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child, nullable.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const OptionalParser<ParserNodeType>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.child(), context);
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a logical AND parser.
+     * The parser does not consume input, so it adds nothing to the first set of a sequence.
+     * @param parser the parser.
+     * @param context the context.
+     * @return an empty, nullable set.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const AndParser<ParserNodeType>& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a logical NOT parser.
+     * The parser does not consume input, so it adds nothing to the first set of a sequence.
+     * @param parser the parser.
+     * @param context the context.
+     * @return an empty, nullable set.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const NotParser<ParserNodeType>& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.setNullable(true);
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a match parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType, class MatchIdType> FirstSet computeFirstSet(const MatchParser<ParserNodeType, MatchIdType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+    /**
+     * Computes the first set of a tree match parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType, class MatchIdType> FirstSet computeFirstSet(const TreeMatchParser<ParserNodeType, MatchIdType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+    /**
+     * Computes the first set of a value match parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType, class MatchIdType> FirstSet computeFirstSet(const ValueMatchParser<ParserNodeType, MatchIdType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+    /**
+     * Computes the first set of an integer number parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the digits, plus '-' for signed types.
+     */
+    template <class T> FirstSet computeFirstSet(const IntegerNumberParser<T>& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.addRange('0', '9');
+        if constexpr (std::is_signed_v<T>) {
+            result.add('-');
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a hexadecimal number parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the hexadecimal digits.
+     */
+    template <class T> FirstSet computeFirstSet(const HexNumberParser<T>& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.addRange('0', '9');
+        result.addRange('a', 'f');
+        result.addRange('A', 'F');
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a floating point number parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the digits, '-' and '.'.
+     */
+    template <class T> FirstSet computeFirstSet(const FloatNumberParser<T>& /*parser*/, FirstSetContext& /*context*/) {
+        FirstSet result;
+        result.addRange('0', '9');
+        result.add('-');
+        result.add('.');
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a skip parser: the first set of the child,
+     * plus the values the skipper can start skipping at.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const SkipParser<ParserNodeType>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.child(), context);
+        result.addSkipper(parser.skipper());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a lexeme parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const LexemeParser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+    /**
+     * Computes the first set of a rule.
+     * Recursive references to a rule under analysis yield a full, nullable set.
+     * @param rule the rule.
+     * @param context the context.
+     * @return the first set.
+     */
+    template <class ParseContextType> FirstSet computeFirstSet(const Rule<ParseContextType>& rule, FirstSetContext& context) {
+        if (!context.enterRule(rule.this_())) {
+            return FirstSet::all();
+        }
+        const FirstSet result = rule.parser()->firstSet(context);
+        context.leaveRule(rule.this_());
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a rule reference.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the referenced rule.
+     */
+    template <class ParseContextType> FirstSet computeFirstSet(const RuleReference<ParseContextType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.rule(), context);
+    }
+
+
+    /**
+     * Computes the first set of a parser or rule.
+     * @param parser the parser or rule.
+     * @param caseSensitive if false, values are added case insensitively.
+     * @return the first set.
+     */
+    template <class ParserType> FirstSet firstSet(const ParserType& parser, bool caseSensitive = true) {
+        FirstSetContext context(caseSensitive);
+        return computeFirstSet(parser, context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_FIRSTSET_HPP
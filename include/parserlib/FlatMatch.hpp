@@ -0,0 +1,374 @@
+#ifndef PARSERLIB_FLATMATCH_HPP
+#define PARSERLIB_FLATMATCH_HPP
+
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace parserlib {
+
+
+    /**
+     * A match stored in a relocatable, offset-based layout.
+     * Records are stored in preorder; the children of a record follow it,
+     * and the next sibling of a record is found by skipping the record's subtree.
+     * All fields are 64-bit, and there are no pointers, so as that records can be placed
+     * in shared memory or files and read in place.
+     */
+    class FlatMatchRecord {
+    public:
+        /**
+         * The default constructor.
+         */
+        FlatMatchRecord() {
+        }
+
+        /**
+         * Constructor.
+         * @param id id of the match.
+         * @param begin begin offset of the match into the source.
+         * @param end end offset of the match into the source.
+         * @param childCount number of children.
+         * @param subtreeSize number of records of the subtree, including this.
+         */
+        FlatMatchRecord(std::uint64_t id, std::uint64_t begin, std::uint64_t end, std::uint64_t childCount, std::uint64_t subtreeSize)
+            : m_id(id), m_begin(begin), m_end(end), m_childCount(childCount), m_subtreeSize(subtreeSize) {
+        }
+
+        /**
+         * Returns the id of the match.
+         * @return the id of the match.
+         */
+        std::uint64_t id() const {
+            return m_id;
+        }
+
+        /**
+         * Returns the begin offset of the match into the source.
+         * @return the begin offset of the match into the source.
+         */
+        std::uint64_t begin() const {
+            return m_begin;
+        }
+
+        /**
+         * Returns the end offset of the match into the source.
+         * @return the end offset of the match into the source.
+         */
+        std::uint64_t end() const {
+            return m_end;
+        }
+
+        /**
+         * Returns the number of children.
+         * @return the number of children.
+         */
+        std::uint64_t childCount() const {
+            return m_childCount;
+        }
+
+        /**
+         * Returns the number of records of the subtree, including this.
+         * @return the number of records of the subtree.
+         */
+        std::uint64_t subtreeSize() const {
+            return m_subtreeSize;
+        }
+
+    private:
+        std::uint64_t m_id{ 0 };
+        std::uint64_t m_begin{ 0 };
+        std::uint64_t m_end{ 0 };
+        std::uint64_t m_childCount{ 0 };
+        std::uint64_t m_subtreeSize{ 0 };
+    };
+
+
+    /**
+     * Header of a flat match layout; it is followed by the records.
+     */
+    class FlatMatchHeader {
+    public:
+        /**
+         * Magic number of the layout.
+         */
+        static constexpr std::uint64_t Magic = 0x3154414C464C5050ULL;
+
+        /**
+         * The default constructor.
+         */
+        FlatMatchHeader() {
+        }
+
+        /**
+         * Constructor.
+         * @param recordCount number of records.
+         * @param rootCount number of root records.
+         */
+        FlatMatchHeader(std::uint64_t recordCount, std::uint64_t rootCount)
+            : m_magic(Magic), m_recordCount(recordCount), m_rootCount(rootCount) {
+        }
+
+        /**
+         * Checks if the header has the correct magic number.
+         * @return true if the header is valid, false otherwise.
+         */
+        bool valid() const {
+            return m_magic == Magic;
+        }
+
+        /**
+         * Returns the number of records.
+         * @return the number of records.
+         */
+        std::uint64_t recordCount() const {
+            return m_recordCount;
+        }
+
+        /**
+         * Returns the number of root records.
+         * @return the number of root records.
+         */
+        std::uint64_t rootCount() const {
+            return m_rootCount;
+        }
+
+    private:
+        std::uint64_t m_magic{ 0 };
+        std::uint64_t m_recordCount{ 0 };
+        std::uint64_t m_rootCount{ 0 };
+    };
+
+
+    /**
+     * Default conversion of match ids to the 64-bit ids of flat match records;
+     * it supports integral and enumeration ids.
+     */
+    class DefaultFlatMatchIdConverter {
+    public:
+        /**
+         * Converts an id.
+         * @param id id.
+         * @return the converted id.
+         */
+        template <class T> std::uint64_t operator ()(const T& id) const {
+            static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Match ids must be integral or enumerations; otherwise, an id converter must be provided.");
+            return static_cast<std::uint64_t>(id);
+        }
+    };
+
+
+    /**
+     * Returns the number of records needed to store the given matches.
+     * @param matches matches.
+     * @return the number of records needed.
+     */
+    template <class MatchType> std::uint64_t flatMatchRecordCount(const std::vector<MatchType>& matches) {
+        std::uint64_t result = 0;
+        for (const MatchType& match : matches) {
+            result += 1 + flatMatchRecordCount(match.children());
+        }
+        return result;
+    }
+
+
+    /**
+     * Returns the number of bytes needed to store the given matches in a flat match layout.
+     * @param matches matches.
+     * @return the number of bytes needed.
+     */
+    template <class MatchType> size_t flatMatchSize(const std::vector<MatchType>& matches) {
+        return sizeof(FlatMatchHeader) + static_cast<size_t>(flatMatchRecordCount(matches)) * sizeof(FlatMatchRecord);
+    }
+
+
+    /**
+     * Writes the records of the given match tree, in preorder.
+     * @param match match.
+     * @param sourceBegin beginning of the source, in order to compute offsets.
+     * @param idConverter converts match ids to 64-bit ids.
+     * @param output where to write the records; there must be room for the records of the whole tree.
+     * @return pointer after the last record written.
+     */
+    template <class MatchType, class SourceIterator, class IdConverter>
+    FlatMatchRecord* writeFlatMatchRecords(const MatchType& match, const SourceIterator& sourceBegin, const IdConverter& idConverter, FlatMatchRecord* output) {
+        FlatMatchRecord* const record = output++;
+        for (const MatchType& child : match.children()) {
+            output = writeFlatMatchRecords(child, sourceBegin, idConverter, output);
+        }
+        new (record) FlatMatchRecord(
+            idConverter(match.id()),
+            static_cast<std::uint64_t>(std::distance(sourceBegin, match.begin().iterator())),
+            static_cast<std::uint64_t>(std::distance(sourceBegin, match.end().iterator())),
+            match.children().size(),
+            static_cast<std::uint64_t>(output - record));
+        return output;
+    }
+
+
+    /**
+     * Writes matches into a caller-provided memory region (e.g. shared memory), in a flat match layout.
+     * The layout contains no pointers; it can be read in place with a FlatMatchView, by another process.
+     * @param matches matches to write.
+     * @param sourceBegin beginning of the source, in order to compute offsets.
+     * @param buffer memory region; it must be aligned to 8 bytes.
+     * @param capacity size of the memory region, in bytes.
+     * @param idConverter converts match ids to 64-bit ids.
+     * @return number of bytes written; 0 if the region is not large enough.
+     */
+    template <class MatchType, class SourceIterator, class IdConverter = DefaultFlatMatchIdConverter>
+    size_t writeFlatMatches(const std::vector<MatchType>& matches, const SourceIterator& sourceBegin, void* buffer, size_t capacity, const IdConverter& idConverter = IdConverter()) {
+        const std::uint64_t recordCount = flatMatchRecordCount(matches);
+        const size_t size = sizeof(FlatMatchHeader) + static_cast<size_t>(recordCount) * sizeof(FlatMatchRecord);
+        if (size > capacity) {
+            return 0;
+        }
+        new (buffer) FlatMatchHeader(recordCount, matches.size());
+        FlatMatchRecord* records = reinterpret_cast<FlatMatchRecord*>(static_cast<char*>(buffer) + sizeof(FlatMatchHeader));
+        for (const MatchType& match : matches) {
+            records = writeFlatMatchRecords(match, sourceBegin, idConverter, records);
+        }
+        return size;
+    }
+
+
+    /**
+     * A read-only view over a flat match layout; records are read in place, without copying.
+     */
+    class FlatMatchView {
+    public:
+        /**
+         * Constructor.
+         * @param data beginning of the layout; it must be aligned to 8 bytes.
+         * @param size size of the memory region, in bytes.
+         * The records are validated in one pass, so as that navigating them cannot leave the region.
+         * @exception std::runtime_error thrown if the region does not contain a valid layout.
+         */
+        FlatMatchView(const void* data, size_t size) {
+            if (reinterpret_cast<std::uintptr_t>(data) % alignof(FlatMatchRecord) != 0) {
+                throw std::runtime_error("Flat match data are not aligned.");
+            }
+            if (size < sizeof(FlatMatchHeader)) {
+                throw std::runtime_error("Flat match data are too small.");
+            }
+            m_header = static_cast<const FlatMatchHeader*>(data);
+            if (!m_header->valid()) {
+                throw std::runtime_error("Flat match data are invalid.");
+            }
+            if (m_header->recordCount() > (size - sizeof(FlatMatchHeader)) / sizeof(FlatMatchRecord)) {
+                throw std::runtime_error("Flat match data are truncated.");
+            }
+            m_records = reinterpret_cast<const FlatMatchRecord*>(static_cast<const char*>(data) + sizeof(FlatMatchHeader));
+            validateRecords();
+        }
+
+        /**
+         * Returns the number of records.
+         * @return the number of records.
+         */
+        size_t size() const {
+            return static_cast<size_t>(m_header->recordCount());
+        }
+
+        /**
+         * Returns the number of root records.
+         * @return the number of root records.
+         */
+        size_t rootCount() const {
+            return static_cast<size_t>(m_header->rootCount());
+        }
+
+        /**
+         * Returns a record.
+         * @param index index of the record.
+         * @return the record.
+         */
+        const FlatMatchRecord& operator [](size_t index) const {
+            return m_records[index];
+        }
+
+        /**
+         * Returns the index of the first child of a record.
+         * @param index index of the record.
+         * @return index of the first child of the record; valid only if the record has children.
+         */
+        size_t firstChild(size_t index) const {
+            return index + 1;
+        }
+
+        /**
+         * Returns the index of the next sibling of a record.
+         * @param index index of the record.
+         * @return index of the next sibling of the record; for the last child of a record,
+         *  it is the index of the record that follows the parent's subtree; for roots, the first root is at index 0.
+         */
+        size_t nextSibling(size_t index) const {
+            return index + static_cast<size_t>(m_records[index].subtreeSize());
+        }
+
+        /**
+         * Returns the records.
+         * @return pointer to the first record.
+         */
+        const FlatMatchRecord* begin() const {
+            return m_records;
+        }
+
+        /**
+         * Returns the end of records.
+         * @return pointer after the last record.
+         */
+        const FlatMatchRecord* end() const {
+            return m_records + size();
+        }
+
+    private:
+        const FlatMatchHeader* m_header;
+        const FlatMatchRecord* m_records;
+
+        //subtree whose children are being checked
+        struct Subtree {
+            std::uint64_t end;
+            std::uint64_t remainingChildCount;
+        };
+
+        //checks that each subtree is within its parent's subtree, and that its children, found via the sibling chain, are as many as declared
+        void validateRecords() const {
+            const std::uint64_t recordCount = m_header->recordCount();
+            std::vector<Subtree> subtrees{ { recordCount, m_header->rootCount() } };
+            for (std::uint64_t index = 0; index < recordCount; ++index) {
+                while (subtrees.back().end == index) {
+                    popSubtree(subtrees);
+                }
+                const FlatMatchRecord& record = m_records[index];
+                Subtree& parent = subtrees.back();
+                if (record.subtreeSize() == 0 || record.subtreeSize() > parent.end - index || parent.remainingChildCount == 0) {
+                    throw std::runtime_error("Flat match records are invalid.");
+                }
+                --parent.remainingChildCount;
+                subtrees.push_back(Subtree{ index + record.subtreeSize(), record.childCount() });
+            }
+            while (!subtrees.empty()) {
+                popSubtree(subtrees);
+            }
+        }
+
+        static void popSubtree(std::vector<Subtree>& subtrees) {
+            if (subtrees.back().remainingChildCount != 0) {
+                throw std::runtime_error("Flat match records are invalid.");
+            }
+            subtrees.pop_back();
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_FLATMATCH_HPP
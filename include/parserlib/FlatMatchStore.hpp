@@ -0,0 +1,283 @@
+#ifndef PARSERLIB_FLATMATCHSTORE_HPP
+#define PARSERLIB_FLATMATCHSTORE_HPP
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Error.hpp"
+#include "FlatMatch.hpp"
+
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARSERLIB_MMAP
+#endif
+
+
+namespace parserlib {
+
+
+    /**
+     * An append-only file of matches, in the flat match layout.
+     * Matches are appended as soon as they can no longer be removed by backtracking,
+     * so as that only the speculative tail of matches is kept in memory.
+     * All offsets and counts are 64-bit, so as that the file can be larger than memory.
+     */
+    class FlatMatchFileStore {
+    public:
+        /**
+         * Constructor.
+         * It creates the file, or truncates it if it exists.
+         * @param path path of the file.
+         * @exception std::runtime_error thrown if the file cannot be created.
+         */
+        FlatMatchFileStore(const std::string& path)
+            : m_file(std::fopen(path.c_str(), "wb"))
+        {
+            if (!m_file) {
+                throw std::runtime_error("Cannot create file: " + path);
+            }
+            writeHeader();
+        }
+
+        FlatMatchFileStore(const FlatMatchFileStore&) = delete;
+
+        FlatMatchFileStore& operator = (const FlatMatchFileStore&) = delete;
+
+        /**
+         * Destructor; it closes the file.
+         */
+        ~FlatMatchFileStore() {
+            if (m_file) {
+                finish();
+            }
+        }
+
+        /**
+         * Returns the number of records appended.
+         * @return the number of records appended.
+         */
+        std::uint64_t recordCount() const {
+            return m_recordCount;
+        }
+
+        /**
+         * Returns the number of root records appended.
+         * @return the number of root records appended.
+         */
+        std::uint64_t rootCount() const {
+            return m_rootCount;
+        }
+
+        /**
+         * Appends matches to the file; they become roots.
+         * @param matches matches to append.
+         * @param sourceBegin beginning of the source, in order to compute offsets.
+         * @param idConverter converts match ids to 64-bit ids.
+         * @exception std::runtime_error thrown if the file cannot be written.
+         */
+        template <class MatchType, class SourceIterator, class IdConverter = DefaultFlatMatchIdConverter>
+        void append(const std::vector<MatchType>& matches, const SourceIterator& sourceBegin, const IdConverter& idConverter = IdConverter()) {
+            const std::uint64_t recordCount = flatMatchRecordCount(matches);
+            m_buffer.resize(static_cast<size_t>(recordCount));
+            FlatMatchRecord* records = m_buffer.data();
+            for (const MatchType& match : matches) {
+                records = writeFlatMatchRecords(match, sourceBegin, idConverter, records);
+            }
+            if (std::fwrite(m_buffer.data(), sizeof(FlatMatchRecord), m_buffer.size(), m_file) != m_buffer.size()) {
+                throw std::runtime_error("Cannot write matches.");
+            }
+            m_recordCount += recordCount;
+            m_rootCount += matches.size();
+        }
+
+        /**
+         * Writes the final header and closes the file; afterwards, the file can be read with a FlatMatchFileView.
+         * @exception std::runtime_error thrown if the file cannot be written.
+         */
+        void close() {
+            if (!finish()) {
+                throw std::runtime_error("Cannot write the match file header.");
+            }
+        }
+
+    private:
+        std::FILE* m_file;
+        std::uint64_t m_recordCount{ 0 };
+        std::uint64_t m_rootCount{ 0 };
+        std::vector<FlatMatchRecord> m_buffer;
+
+        bool finish() {
+            const bool ok = std::fseek(m_file, 0, SEEK_SET) == 0 && writeHeader();
+            const bool closed = std::fclose(m_file) == 0;
+            m_file = nullptr;
+            return ok && closed;
+        }
+
+        bool writeHeader() {
+            const FlatMatchHeader header(m_recordCount, m_rootCount);
+            return std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+        }
+    };
+
+
+    /**
+     * A read-only view of a file written by a FlatMatchFileStore.
+     * On POSIX systems the file is memory-mapped, so as that records are paged in on demand;
+     * elsewhere, the whole file is read into memory, and therefore the file must fit in memory.
+     */
+    class FlatMatchFileView {
+    public:
+        /**
+         * Constructor.
+         * @param path path of the file.
+         * @exception std::runtime_error thrown if the file cannot be read or is not valid.
+         */
+        FlatMatchFileView(const std::string& path) {
+            #ifdef PARSERLIB_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Cannot open file: " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot read file: " + path);
+            }
+            if (st.st_size < 0 || static_cast<std::uintmax_t>(st.st_size) > std::numeric_limits<size_t>::max()) {
+                ::close(fd);
+                throw std::runtime_error("Cannot read file: " + path);
+            }
+            m_size = static_cast<size_t>(st.st_size);
+            void* data = m_size ? ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            ::close(fd);
+            if (data == MAP_FAILED) {
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            m_data = data;
+            #else
+            //the size is queried as 64-bit, since 'long' is 32-bit on some systems
+            std::error_code ec;
+            const std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+            if (ec || fileSize > std::numeric_limits<size_t>::max()) {
+                throw std::runtime_error("Cannot read file: " + path);
+            }
+            m_size = static_cast<size_t>(fileSize);
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            if (!file) {
+                throw std::runtime_error("Cannot open file: " + path);
+            }
+            m_buffer.resize((m_size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+            //read in chunks, since some C libraries cannot read more than 2 GB at once
+            char* const buffer = reinterpret_cast<char*>(m_buffer.data());
+            size_t readSize = 0;
+            while (readSize < m_size) {
+                const size_t chunkSize = std::min(m_size - readSize, static_cast<size_t>(1) << 26);
+                if (std::fread(buffer + readSize, 1, chunkSize, file) != chunkSize) {
+                    break;
+                }
+                readSize += chunkSize;
+            }
+            std::fclose(file);
+            if (readSize != m_size) {
+                throw std::runtime_error("Cannot read file: " + path);
+            }
+            m_data = m_buffer.data();
+            #endif
+
+            try {
+                m_view = std::make_unique<FlatMatchView>(m_data, m_size);
+            }
+            catch (...) {
+                unmap();
+                throw;
+            }
+        }
+
+        FlatMatchFileView(const FlatMatchFileView&) = delete;
+
+        FlatMatchFileView& operator = (const FlatMatchFileView&) = delete;
+
+        /**
+         * Destructor; it unmaps the file.
+         */
+        ~FlatMatchFileView() {
+            unmap();
+        }
+
+        /**
+         * Returns the view over the records of the file.
+         * @return the view over the records of the file.
+         */
+        const FlatMatchView& view() const {
+            return *m_view;
+        }
+
+    private:
+        const void* m_data{ nullptr };
+        size_t m_size{ 0 };
+        std::unique_ptr<FlatMatchView> m_view;
+        #ifndef PARSERLIB_MMAP
+        std::vector<std::uint64_t> m_buffer;
+        #endif
+
+        void unmap() {
+            #ifdef PARSERLIB_MMAP
+            if (m_data) {
+                ::munmap(const_cast<void*>(m_data), m_size);
+                m_data = nullptr;
+            }
+            #endif
+        }
+    };
+
+
+    /**
+     * Parses a sequence of top-level items, appending the matches of each item to a store
+     * as soon as the item is parsed; between items, matches cannot be removed by backtracking,
+     * so the memory used for matches is bounded by the matches of one item.
+     * Parsing stops when the item parser fails or does not advance.
+     * The errors and memoized results of the context are cleared before each item;
+     * the errors of each item, including the ones committed by error recovery, are appended to the given container first.
+     * @param item parser of a top-level item.
+     * @param pc parse context; it must not be used by an enclosing parser.
+     * @param store store to append the matches to.
+     * @param errors container to append the errors of each item to.
+     * @param idConverter converts match ids to 64-bit ids.
+     * @return true if the whole source was parsed, false otherwise.
+     */
+    template <class ParserType, class ParseContextType, class IdConverter = DefaultFlatMatchIdConverter>
+    bool parseToStore(const ParserType& item, ParseContextType& pc, FlatMatchFileStore& store, ErrorContainer<typename ParseContextType::PositionType>& errors, const IdConverter& idConverter = IdConverter()) {
+        while (!pc.sourceEnded()) {
+            pc.clearErrors();
+            pc.memoTable().clear();
+            const auto start = pc.sourcePosition();
+            const bool parsed = item(pc) && pc.sourcePosition() != start;
+            errors.insert(errors.end(), pc.errors().begin(), pc.errors().end());
+            if (!parsed) {
+                break;
+            }
+            store.append(pc.matches(), pc.sourceBegin(), idConverter);
+            pc.clearMatches();
+        }
+        store.append(pc.matches(), pc.sourceBegin(), idConverter);
+        pc.clearMatches();
+        return pc.sourceEnded();
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_FLATMATCHSTORE_HPP
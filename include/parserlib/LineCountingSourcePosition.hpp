@@ -55,7 +55,7 @@ namespace parserlib {
          * @param begin iterator to the first element of the source.
          * @param end iterator to the end of the source.
          */
-        LineCountingSourcePosition(const typename SourceType::const_iterator& begin, const typename SourceType::const_iterator& end)
+        LineCountingSourcePosition(const SourceIterator<SourceType>& begin, const SourceIterator<SourceType>& end)
             : SourcePosition<SourceType, CaseSensitive>(begin, end)
         {
         }
@@ -77,12 +77,13 @@ namespace parserlib {
 
         /**
          * Increases the position by multiple places.
-         * It also increases the column value by the given amount.
+         * It also increments column/line for each place, depending on if the skipped sequence contains newlines.
          * @param count number of places to increase the position by.
          */
         void increase(size_t count) {
-            m_column += count;
-            SourcePosition<SourceType, CaseSensitive>::increase(count);
+            for (; count > 0; --count) {
+                increment();
+            }
         }
 
         /**
@@ -0,0 +1,234 @@
+#ifndef PARSERLIB_LISTPARSER_HPP
+#define PARSERLIB_LISTPARSER_HPP
+
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "ParserNode.hpp"
+#include "TerminalParser.hpp"
+#include "TerminalStringParser.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that parses a list of items separated by a separator, i.e. 'item >> *(separator >> item)'.
+     *
+     * Each iteration keeps one checkpoint, taken before the separator, instead of
+     * one for the loop and one for the sequence; and once the list is long enough,
+     * room for the matches of the rest of the list is reserved from the matches per item seen so far,
+     * so as that long lists reallocate the match container a few times only.
+     * @param ItemType type of item parser.
+     * @param SeparatorType type of separator parser.
+     */
+    template <class ItemType, class SeparatorType> class ListParser : public ParserNode<ListParser<ItemType, SeparatorType>> {
+    public:
+        /**
+         * Constructor.
+         * @param item item parser.
+         * @param separator separator parser.
+         * @param minCount min number of items.
+         * @param maxCount max number of items.
+         * @param allowTrailingSeparator if true, the list may end with a separator.
+         * @exception std::invalid_argument thrown if the max count is 0 or less than the min count.
+         */
+        ListParser(const ItemType& item, const SeparatorType& separator, size_t minCount, size_t maxCount, bool allowTrailingSeparator)
+            : m_item(item), m_separator(separator), m_minCount(minCount), m_maxCount(maxCount), m_allowTrailingSeparator(allowTrailingSeparator)
+        {
+            if (maxCount == 0 || maxCount < minCount) {
+                throw std::invalid_argument("Invalid list item count range.");
+            }
+        }
+
+        /**
+         * Returns the item parser.
+         * @return the item parser.
+         */
+        const ItemType& item() const {
+            return m_item;
+        }
+
+        /**
+         * Returns the separator parser.
+         * @return the separator parser.
+         */
+        const SeparatorType& separator() const {
+            return m_separator;
+        }
+
+        /**
+         * Returns the min number of items.
+         * @return the min number of items.
+         */
+        size_t minCount() const {
+            return m_minCount;
+        }
+
+        /**
+         * Returns the max number of items.
+         * @return the max number of items.
+         */
+        size_t maxCount() const {
+            return m_maxCount;
+        }
+
+        /**
+         * Checks if the list may end with a separator.
+         * @return true if the list may end with a separator, false otherwise.
+         */
+        bool allowTrailingSeparator() const {
+            return m_allowTrailingSeparator;
+        }
+
+        /**
+         * Parses the list.
+         * @param pc parse context.
+         * @return true if at least min count items are parsed, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return parse(pc, [&]() { return m_item(pc); });
+        }
+
+        /**
+         * Parses the list; the first item is parsed as a left recursion continuation.
+         * The object is called to parse within a left recursion parsing context,
+         * in order to continue parsing after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return parse(pc, [&]() { return m_item.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        //number of items after which match capacity is reserved
+        static constexpr size_t ReserveItemCount = 16;
+
+        //max number of items to reserve matches for, relative to the number of items parsed so far
+        static constexpr size_t ReserveGrowthFactor = 4;
+
+        const ItemType m_item;
+        const SeparatorType m_separator;
+        const size_t m_minCount;
+        const size_t m_maxCount;
+        const bool m_allowTrailingSeparator;
+
+        template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
+            const auto initialState = pc.state();
+            const auto errorState = pc.errorState();
+
+            //parse the first item with the given function
+            if (!pf()) {
+                if (m_minCount > 0) {
+                    return false;
+                }
+                pc.setErrorState(errorState);
+                return true;
+            }
+
+            //parse separator and item pairs, with one checkpoint per iteration
+            size_t count = 1;
+            while (count < m_maxCount) {
+                const auto checkpoint = pc.state();
+
+                //if there is no separator, the list ends
+                if (!m_separator(pc)) {
+                    break;
+                }
+
+                //if there is no item after the separator, the list ends before the separator, unless trailing separators are allowed
+                if (!m_item(pc)) {
+                    if (!m_allowTrailingSeparator) {
+                        pc.setState(checkpoint);
+                    }
+                    break;
+                }
+
+                //if no advance was made, stop in order to avoid an infinite loop
+                if (pc.sourcePosition() == checkpoint.sourcePosition()) {
+                    break;
+                }
+
+                ++count;
+
+                //when the list gets long, reserve room for the matches of the rest of the list
+                if (count >= ReserveItemCount && (count & (count - 1)) == 0) {
+                    reserveMatches(pc, initialState, count);
+                }
+            }
+
+            //check the min count
+            if (count < m_minCount) {
+                pc.setState(initialState);
+                return false;
+            }
+
+            pc.setErrorState(errorState);
+            return true;
+        }
+
+        //reserves room for the matches of the rest of the list, using the matches per item seen so far;
+        //for random access sources, the number of remaining items is estimated from the source length per item seen so far
+        template <class ParseContextType, class StateType> void reserveMatches(ParseContextType& pc, const StateType& initialState, size_t count) const {
+            const size_t matchesPerItem = (pc.matches().size() - initialState.matchCount()) / count;
+
+            //if there is room for the items until the next check, do nothing
+            if (pc.matches().capacity() - pc.matches().size() >= matchesPerItem * count) {
+                return;
+            }
+
+            size_t itemCount = std::min(count * ReserveGrowthFactor, m_maxCount - count);
+            using Iterator = SourceIterator<typename ParseContextType::SourceType>;
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+                const auto parsedLength = static_cast<size_t>(pc.sourcePosition().iterator() - initialState.sourcePosition().iterator());
+                const auto remainingLength = static_cast<size_t>(pc.sourceEnd() - pc.sourcePosition().iterator());
+                itemCount = std::min(itemCount, remainingLength * count / parsedLength + 1);
+            }
+            pc.reserveMatches(matchesPerItem * itemCount);
+        }
+    };
+
+
+    /**
+     * Creates a list parser, i.e. a parser for 'item >> *(separator >> item)'.
+     * @param item item parser.
+     * @param separator separator parser.
+     * @param minCount min number of items; if 0, the list may be empty.
+     * @param maxCount max number of items.
+     * @param allowTrailingSeparator if true, the list may end with a separator.
+     * @return a list parser.
+     * @exception std::invalid_argument thrown if the max count is 0 or less than the min count.
+     */
+    template <class ItemType, class SeparatorType>
+    ListParser<ItemType, SeparatorType>
+    list(const ParserNode<ItemType>& item, const ParserNode<SeparatorType>& separator, size_t minCount = 1, size_t maxCount = std::numeric_limits<size_t>::max(), bool allowTrailingSeparator = false) {
+        return { static_cast<const ItemType&>(item), static_cast<const SeparatorType&>(separator), minCount, maxCount, allowTrailingSeparator };
+    }
+
+
+    /**
+     * Creates a list parser with a terminal separator.
+     * @param item item parser.
+     * @param separator terminal separator.
+     * @param minCount min number of items; if 0, the list may be empty.
+     * @param maxCount max number of items.
+     * @param allowTrailingSeparator if true, the list may end with a separator.
+     * @return a list parser.
+     * @exception std::invalid_argument thrown if the max count is 0 or less than the min count.
+     */
+    template <class ItemType, class TerminalType, std::enable_if_t<!std::is_base_of_v<ParserNodeBase, TerminalType>, int> = 0>
+    auto list(const ParserNode<ItemType>& item, const TerminalType& separator, size_t minCount = 1, size_t maxCount = std::numeric_limits<size_t>::max(), bool allowTrailingSeparator = false) {
+        return list(item, terminal(separator), minCount, maxCount, allowTrailingSeparator);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_LISTPARSER_HPP
@@ -2,9 +2,23 @@
 #define PARSERLIB_MATCH_HPP
 
 
+#include <vector>
+#include <variant>
+#include <type_traits>
+#include "util.hpp"
+
+
 namespace parserlib {
 
 
+    /**
+     * Value that can be stored in a match by parsers that convert the input they parse,
+     * e.g. number parsers.
+     * It is empty (std::monostate) for matches that carry no value.
+     */
+    using MatchValue = std::variant<std::monostate, long long, unsigned long long, double>;
+
+
     /**
      * Result of a successful parsing attempt.
      * @param SourceType container with source data.
@@ -13,6 +27,11 @@ namespace parserlib {
      */
     template <class SourceType, class MatchIdType, class PositionType> class Match {
     public:
+        /**
+         * Type of the parsed content; see SourceContent.
+         */
+        using ContentType = typename SourceContent<SourceType>::type;
+
         /**
          * The default constructor.
          * No member is initialized.
@@ -35,6 +54,21 @@ namespace parserlib {
         {
         }
 
+        /**
+         * Constructor from parameters and value.
+         * @param id id of match.
+         * @param begin begin position of match.
+         * @param end end position of match.
+         * @param value value of match.
+         */
+        Match(const MatchIdType& id,
+            const PositionType& begin,
+            const PositionType& end,
+            const MatchValue& value)
+            : m_id(id), m_begin(begin), m_end(end), m_value(value)
+        {
+        }
+
         /**
          * Returns the id of the match.
          * @return the id of the match.
@@ -63,8 +97,8 @@ namespace parserlib {
          * Returns the parsed content.
          * @return the parsed content.
          */
-        SourceType content() const {
-            return SourceType(m_begin.iterator(), m_end.iterator());
+        ContentType content() const {
+            return makeSubSource<ContentType>(m_begin.iterator(), m_end.iterator());
         }
 
         /**
@@ -75,11 +109,36 @@ namespace parserlib {
             return m_children;
         }
 
+        /**
+         * Returns the value of the match.
+         * @return the value of the match; empty if the match has no value.
+         */
+        const MatchValue& value() const {
+            return m_value;
+        }
+
+        /**
+         * Returns the value of the match, converted to the given type.
+         * @param T type to convert the value to.
+         * @return the converted value, or T() if the match has no value.
+         */
+        template <class T> T valueAs() const {
+            return std::visit([](const auto& v) -> T {
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                    return T();
+                }
+                else {
+                    return static_cast<T>(v);
+                }
+            }, m_value);
+        }
+
     private:
-        const MatchIdType m_id{};
-        const PositionType m_begin;
-        const PositionType m_end;
-        const std::vector<Match> m_children;
+        MatchIdType m_id{};
+        PositionType m_begin;
+        PositionType m_end;
+        std::vector<Match> m_children;
+        MatchValue m_value;
     };
 
 
@@ -0,0 +1,291 @@
+#ifndef PARSERLIB_MATCHDAG_HPP
+#define PARSERLIB_MATCHDAG_HPP
+
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include "Match.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A compact representation of match trees, in which identical subtrees are stored once.
+     *
+     * Subtrees are identical if they have the same id, content, value and children;
+     * they are interned by a structural hash, and therefore two subtrees are equal if and only if they have the same node id.
+     * A node is keyed on its id, length, value and children nodes, and on the source elements between its children only,
+     * since the content of the children is identified by their nodes; therefore each source element is hashed once,
+     * at the deepest match that contains it.
+     *
+     * Nodes do not copy their content; they refer to the source of the first match they were created from,
+     * which must outlive the DAG.
+     *
+     * The positions of matches are stored separately from nodes, as a preorder list of source offsets;
+     * the end of a match is its begin offset plus the length of its node.
+     * @param MatchType type of match to intern.
+     */
+    template <class MatchType> class MatchDag {
+    public:
+        /**
+         * Match id type.
+         */
+        using MatchIdType = std::decay_t<decltype(std::declval<MatchType>().id())>;
+
+        /**
+         * Content type.
+         */
+        using ContentType = decltype(std::declval<MatchType>().content());
+
+        /**
+         * Source iterator type.
+         */
+        using SourceIteratorType = std::decay_t<decltype(std::declval<MatchType>().begin().iterator())>;
+
+        /**
+         * Node id type; an index into the node table.
+         */
+        using NodeId = size_t;
+
+        /**
+         * An interned subtree.
+         */
+        class Node {
+        public:
+            /**
+             * Returns the id of the match.
+             * @return the id of the match.
+             */
+            const MatchIdType& id() const {
+                return m_id;
+            }
+
+            /**
+             * Returns the content of the match.
+             * @return the content of the match, as a source over the first match the node was created from.
+             */
+            ContentType content() const {
+                return makeSubSource<ContentType>(m_begin, std::next(m_begin, static_cast<std::ptrdiff_t>(m_length)));
+            }
+
+            /**
+             * Returns the number of source elements of the match.
+             * @return the number of source elements of the match.
+             */
+            size_t length() const {
+                return m_length;
+            }
+
+            /**
+             * Returns the value of the match.
+             * @return the value of the match.
+             */
+            const MatchValue& value() const {
+                return m_value;
+            }
+
+            /**
+             * Returns the children nodes.
+             * @return the children nodes.
+             */
+            const std::vector<NodeId>& children() const {
+                return m_children;
+            }
+
+            /**
+             * Returns the structural hash of the subtree.
+             * @return the structural hash of the subtree.
+             */
+            size_t hash() const {
+                return m_hash;
+            }
+
+            /**
+             * Returns the number of matches in the subtree, including this.
+             * @return the number of matches in the subtree.
+             */
+            size_t subtreeSize() const {
+                return m_subtreeSize;
+            }
+
+        private:
+            MatchIdType m_id;
+            SourceIteratorType m_begin;
+            size_t m_length;
+            MatchValue m_value;
+            std::vector<NodeId> m_children;
+            std::vector<size_t> m_gapLengths;
+            size_t m_hash;
+            size_t m_subtreeSize;
+
+            friend MatchDag;
+        };
+
+        /**
+         * Adds match trees to the DAG.
+         * @param matches matches to add; they become roots.
+         * @param sourceBegin the beginning of the source of the matches; used for computing offsets.
+         */
+        void add(const std::vector<MatchType>& matches, const SourceIteratorType& sourceBegin) {
+            for (const MatchType& match : matches) {
+                m_roots.push_back(intern(match, sourceBegin));
+            }
+        }
+
+        /**
+         * Returns the nodes.
+         * @return the nodes.
+         */
+        const std::vector<Node>& nodes() const {
+            return m_nodes;
+        }
+
+        /**
+         * Returns a node.
+         * @param nodeId id of the node.
+         * @return the node.
+         */
+        const Node& node(NodeId nodeId) const {
+            return m_nodes[nodeId];
+        }
+
+        /**
+         * Returns the root nodes, one for each match added, in the order added.
+         * @return the root nodes.
+         */
+        const std::vector<NodeId>& roots() const {
+            return m_roots;
+        }
+
+        /**
+         * Returns the begin offsets of all matches, in preorder:
+         * the offsets of a root's subtree are followed by the offsets of the next root's subtree.
+         * @return the begin offsets of all matches.
+         */
+        const std::vector<size_t>& offsets() const {
+            return m_offsets;
+        }
+
+        /**
+         * Checks if two subtrees are equal, in O(1).
+         * @param a id of the first node.
+         * @param b id of the second node.
+         * @return true if the subtrees are equal, false otherwise.
+         */
+        static bool equal(NodeId a, NodeId b) {
+            return a == b;
+        }
+
+        /**
+         * Invokes a function for each match of the DAG in preorder, with the match's node, begin offset, end offset and depth.
+         * @param func function to invoke.
+         */
+        template <class F> void forEach(const F& func) const {
+            size_t offsetIndex = 0;
+            for (const NodeId root : m_roots) {
+                forEach(root, offsetIndex, 0, func);
+            }
+        }
+
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<NodeId> m_roots;
+        std::vector<size_t> m_offsets;
+        std::unordered_map<size_t, std::vector<NodeId>> m_buckets;
+
+        static size_t combine(size_t seed, size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        NodeId intern(const MatchType& match, const SourceIteratorType& sourceBegin) {
+            m_offsets.push_back(static_cast<size_t>(std::distance(sourceBegin, match.begin().iterator())));
+
+            Node node;
+            node.m_id = match.id();
+            node.m_begin = match.begin().iterator();
+            node.m_length = static_cast<size_t>(std::distance(match.begin().iterator(), match.end().iterator()));
+            node.m_value = match.value();
+            node.m_subtreeSize = 1;
+            node.m_children.reserve(match.children().size());
+            node.m_gapLengths.reserve(match.children().size() + 1);
+
+            size_t hash = std::hash<MatchIdType>()(node.m_id);
+            hash = combine(hash, node.m_length);
+            hash = combine(hash, std::hash<MatchValue>()(node.m_value));
+
+            //hash the children by node, and the elements between them by value
+            SourceIteratorType gapBegin = node.m_begin;
+            for (const MatchType& child : match.children()) {
+                const NodeId childId = intern(child, sourceBegin);
+                node.m_children.push_back(childId);
+                node.m_subtreeSize += m_nodes[childId].m_subtreeSize;
+                hash = combineGap(hash, node, gapBegin, child.begin().iterator());
+                hash = combine(hash, childId);
+                gapBegin = child.end().iterator();
+            }
+            hash = combineGap(hash, node, gapBegin, match.end().iterator());
+            node.m_hash = hash;
+
+            std::vector<NodeId>& bucket = m_buckets[hash];
+            for (const NodeId nodeId : bucket) {
+                if (equalKeys(m_nodes[nodeId], node)) {
+                    return nodeId;
+                }
+            }
+
+            const NodeId nodeId = m_nodes.size();
+            m_nodes.push_back(std::move(node));
+            bucket.push_back(nodeId);
+            return nodeId;
+        }
+
+        //adds the length of a gap between children to a node, and combines the gap elements with the hash
+        static size_t combineGap(size_t hash, Node& node, SourceIteratorType it, const SourceIteratorType& end) {
+            size_t length = 0;
+            for (; it != end; ++it, ++length) {
+                hash = combine(hash, std::hash<std::decay_t<decltype(*it)>>()(*it));
+            }
+            node.m_gapLengths.push_back(length);
+            return combine(hash, length);
+        }
+
+        //compares the keys of two nodes; the content of nodes with the same children and gaps differs only in the gap elements
+        bool equalKeys(const Node& a, const Node& b) const {
+            if (!(a.m_id == b.m_id && a.m_length == b.m_length && a.m_children == b.m_children && a.m_gapLengths == b.m_gapLengths && a.m_value == b.m_value)) {
+                return false;
+            }
+            SourceIteratorType itA = a.m_begin;
+            SourceIteratorType itB = b.m_begin;
+            for (size_t index = 0; index < a.m_gapLengths.size(); ++index) {
+                const auto gapLength = static_cast<std::ptrdiff_t>(a.m_gapLengths[index]);
+                if (!std::equal(itA, std::next(itA, gapLength), itB)) {
+                    return false;
+                }
+                if (index < a.m_children.size()) {
+                    const auto childLength = static_cast<std::ptrdiff_t>(m_nodes[a.m_children[index]].m_length);
+                    itA = std::next(itA, gapLength + childLength);
+                    itB = std::next(itB, gapLength + childLength);
+                }
+            }
+            return true;
+        }
+
+        template <class F> void forEach(NodeId nodeId, size_t& offsetIndex, size_t depth, const F& func) const {
+            const Node& node = m_nodes[nodeId];
+            const size_t begin = m_offsets[offsetIndex++];
+            func(node, begin, begin + node.m_length, depth);
+            for (const NodeId childId : node.m_children) {
+                forEach(childId, offsetIndex, depth + 1, func);
+            }
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_MATCHDAG_HPP
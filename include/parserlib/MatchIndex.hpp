@@ -0,0 +1,209 @@
+#ifndef PARSERLIB_MATCHINDEX_HPP
+#define PARSERLIB_MATCHINDEX_HPP
+
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <vector>
+#include "Match.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * An index over match trees, built in one pass after parsing, for queries by id and by source offset.
+     *
+     * The matches are stored in preorder, i.e. in the order of their begin offsets, with parents before their children;
+     * the matches of each id are stored in a separate list, in the same order.
+     * Queries do not walk the match trees:
+     *  - the matches of an id are found in O(log n), and the ones that begin in a range of offsets in O(log n + k);
+     *  - the innermost match that contains an offset is found in O(log n + d), where d is the depth of the match tree;
+     *  - the children of a match are found in O(k).
+     *
+     * The index refers to the matches it is built from; they must not be modified or destroyed while the index is used.
+     * @param MatchType type of match to index.
+     */
+    template <class MatchType> class MatchIndex {
+    public:
+        /**
+         * Match id type.
+         */
+        using MatchIdType = std::decay_t<decltype(std::declval<MatchType>().id())>;
+
+        /**
+         * Source iterator type.
+         */
+        using SourceIteratorType = std::decay_t<decltype(std::declval<MatchType>().begin().iterator())>;
+
+        /**
+         * Index value that denotes no match.
+         */
+        static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+        /**
+         * An indexed match.
+         */
+        class Entry {
+        public:
+            /**
+             * Returns the match.
+             * @return the match.
+             */
+            const MatchType& match() const {
+                return *m_match;
+            }
+
+            /**
+             * Returns the offset the match begins at.
+             * @return the begin offset.
+             */
+            size_t begin() const {
+                return m_begin;
+            }
+
+            /**
+             * Returns the offset the match ends at.
+             * @return the end offset.
+             */
+            size_t end() const {
+                return m_end;
+            }
+
+            /**
+             * Returns the index of the parent match.
+             * @return the index of the parent match, or None if the match is a root.
+             */
+            size_t parent() const {
+                return m_parent;
+            }
+
+            /**
+             * Returns the index after the last match of the subtree of the match.
+             * @return the index after the subtree.
+             */
+            size_t subtreeEnd() const {
+                return m_subtreeEnd;
+            }
+
+        private:
+            const MatchType* m_match;
+            size_t m_begin;
+            size_t m_end;
+            size_t m_parent;
+            size_t m_subtreeEnd;
+
+            friend MatchIndex;
+        };
+
+        /**
+         * Builds the index.
+         * @param matches matches to index; they are the roots of the match trees.
+         * @param sourceBegin the beginning of the source of the matches; used for computing offsets.
+         */
+        MatchIndex(const std::vector<MatchType>& matches, const SourceIteratorType& sourceBegin) {
+            for (const MatchType& match : matches) {
+                add(match, None, sourceBegin);
+            }
+        }
+
+        /**
+         * Returns the number of indexed matches.
+         * @return the number of indexed matches.
+         */
+        size_t size() const {
+            return m_entries.size();
+        }
+
+        /**
+         * Returns an indexed match.
+         * @param index index of the match.
+         * @return the indexed match.
+         */
+        const Entry& operator [](size_t index) const {
+            return m_entries[index];
+        }
+
+        /**
+         * Returns the matches with the given id.
+         * @param id match id.
+         * @return indexes of the matches with the given id, in the order of their begin offsets.
+         */
+        const std::vector<size_t>& byId(const MatchIdType& id) const {
+            static const std::vector<size_t> empty;
+            const auto it = m_byId.find(id);
+            return it != m_byId.end() ? it->second : empty;
+        }
+
+        /**
+         * Returns the matches with the given id that begin within a range of offsets.
+         * @param id match id.
+         * @param beginOffset start of the range.
+         * @param endOffset end of the range (exclusive).
+         * @return indexes of the matches, in the order of their begin offsets.
+         */
+        std::vector<size_t> byId(const MatchIdType& id, size_t beginOffset, size_t endOffset) const {
+            const std::vector<size_t>& indexes = byId(id);
+            const auto compare = [&](size_t index, size_t offset) { return m_entries[index].m_begin < offset; };
+            const auto first = std::lower_bound(indexes.begin(), indexes.end(), beginOffset, compare);
+            const auto last = std::lower_bound(first, indexes.end(), endOffset, compare);
+            return std::vector<size_t>(first, last);
+        }
+
+        /**
+         * Returns the innermost match that contains an offset, i.e. that begins at or before it and ends after it.
+         * @param offset source offset.
+         * @return index of the innermost match that contains the offset, or None if there is no such match.
+         */
+        size_t innermost(size_t offset) const {
+            //the last match that begins at or before the offset; the matches that contain the offset are it or its ancestors,
+            //since siblings do not overlap
+            const auto it = std::upper_bound(m_entries.begin(), m_entries.end(), offset, [](size_t offset, const Entry& entry) { return offset < entry.m_begin; });
+            size_t index = it == m_entries.begin() ? None : static_cast<size_t>(std::distance(m_entries.begin(), it)) - 1;
+            while (index != None && m_entries[index].m_end <= offset) {
+                index = m_entries[index].m_parent;
+            }
+            return index;
+        }
+
+        /**
+         * Returns the children of a match.
+         * @param index index of the match.
+         * @return indexes of the children matches.
+         */
+        std::vector<size_t> children(size_t index) const {
+            std::vector<size_t> result;
+            for (size_t child = index + 1; child < m_entries[index].m_subtreeEnd; child = m_entries[child].m_subtreeEnd) {
+                result.push_back(child);
+            }
+            return result;
+        }
+
+    private:
+        std::vector<Entry> m_entries;
+        std::map<MatchIdType, std::vector<size_t>> m_byId;
+
+        void add(const MatchType& match, size_t parent, const SourceIteratorType& sourceBegin) {
+            const size_t index = m_entries.size();
+            Entry entry;
+            entry.m_match = &match;
+            entry.m_begin = static_cast<size_t>(std::distance(sourceBegin, match.begin().iterator()));
+            entry.m_end = static_cast<size_t>(std::distance(sourceBegin, match.end().iterator()));
+            entry.m_parent = parent;
+            m_entries.push_back(entry);
+            m_byId[match.id()].push_back(index);
+            for (const MatchType& child : match.children()) {
+                add(child, index, sourceBegin);
+            }
+            m_entries[index].m_subtreeEnd = m_entries.size();
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_MATCHINDEX_HPP
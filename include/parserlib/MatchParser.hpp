@@ -68,12 +68,14 @@ namespace parserlib {
         const MatchIdType m_matchId;
 
         template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
-            const auto begin = pc.sourcePosition();
-            if (pf()) {
-                pc.addMatch(m_matchId, begin, pc.sourcePosition());
-                return true;
-            }
-            return false;
+            return pc.parseAfterSkip([&]() {
+                const auto begin = pc.sourcePosition();
+                if (pf()) {
+                    pc.addMatch(m_matchId, begin, pc.sourcePosition());
+                    return true;
+                }
+                return false;
+                });
         }
 
     };
@@ -0,0 +1,183 @@
+#ifndef PARSERLIB_MEMOPARSER_HPP
+#define PARSERLIB_MEMOPARSER_HPP
+
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "ParserNode.hpp"
+#include "Rule.hpp"
+#include "FirstSet.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that stores the result of its child at each source position it is invoked at,
+     * and replays the stored result when it is invoked again at the same position
+     * (packrat parsing).
+     *
+     * If the rules of a grammar are memoized, then no rule is parsed more than once at a source position,
+     * and therefore the number of parser invocations is linear to the source length, for any amount of backtracking.
+     * Stored matches are copies, including their children, and they are copied again when replayed;
+     * therefore the parse time is O(n * d), where n is the source length and d is the nesting depth of the matches
+     * produced by memoized parsers; it is linear to the source length if the depth is bounded.
+     * The result is the same as without memoization, i.e. the one of ordered choice.
+     *
+     * Results are stored in the memo table of the parse context, or in the memo table it shares with other contexts,
+     * by parser, source offset and skipper;
+     * results that depend on left recursion being resolved are not stored.
+     * @param ParserNodeType type of child.
+     */
+    template <class ParserNodeType> class MemoParser : public ParserNode<MemoParser<ParserNodeType>> {
+    public:
+        /**
+         * Constructor.
+         * @param child the parser to memoize.
+         * @param id id of the parser in memo tables; if null, a new id is created.
+         */
+        MemoParser(const ParserNodeType& child, const void* id = nullptr)
+            : m_child(child), m_token(id ? nullptr : std::make_shared<const char>(0)), m_id(id ? id : m_token.get())
+        {
+        }
+
+        /**
+         * Returns the child.
+         * @return the child.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Returns the id of the parser in memo tables; copies of the parser have the same id.
+         * @return the id of the parser.
+         */
+        const void* id() const {
+            return m_id;
+        }
+
+        /**
+         * Replays the result of the child at the current position, if stored; otherwise, invokes the child and stores its result.
+         * @param pc parse context.
+         * @return the result of the child.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            auto& memoTable = pc.memoTable();
+            const auto& sharedMemoTable = pc.sharedMemoTable();
+            const size_t offset = static_cast<size_t>(std::distance(pc.sourceBegin(), pc.sourcePosition().iterator()));
+
+            //replay
+            if (const auto* entry = sharedMemoTable ? sharedMemoTable->find(id(), offset, pc.skipper()) : memoTable.find(id(), offset, pc.skipper())) {
+                return replay(pc, *entry);
+            }
+
+            //parse
+            const size_t matchCount = pc.matches().size();
+            const size_t errorCount = pc.errors().size();
+            const size_t committedErrorCount = pc.committedErrorCount();
+            const size_t leftRecursionCount = pc.leftRecursionCount();
+            const auto priorErrorPosition = errorCount > committedErrorCount ? std::make_optional(pc.errors().back().position()) : std::nullopt;
+            const bool result = m_child(pc);
+
+            //store
+            if (pc.leftRecursionCount() == leftRecursionCount) {
+                using EntryType = typename ParseContextType::MemoTableType::EntryType;
+
+                //the uncommitted error the child was invoked with belongs to the caller, unless the child replaced it
+                const bool priorErrorReplaced = priorErrorPosition && pc.errors()[committedErrorCount].position() != *priorErrorPosition;
+                const size_t firstError = priorErrorPosition && !priorErrorReplaced ? errorCount : committedErrorCount;
+                const bool commitsPriorError = priorErrorPosition && !priorErrorReplaced && pc.committedErrorCount() > committedErrorCount;
+
+                EntryType entry(result, pc.sourcePosition(),
+                    std::vector<typename ParseContextType::MatchType>(pc.matches().begin() + matchCount, pc.matches().end()),
+                    std::vector<Error<typename ParseContextType::PositionType>>(pc.errors().begin() + firstError, pc.errors().end()),
+                    std::max(pc.committedErrorCount(), firstError) - firstError,
+                    commitsPriorError);
+
+                if (sharedMemoTable) {
+                    sharedMemoTable->insert(id(), offset, pc.skipper(), std::move(entry));
+                }
+                else {
+                    memoTable.insert(id(), offset, pc.skipper(), std::move(entry));
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * Invokes the child as a left recursion continuation; the result is not memoized.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return the result of the child.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return m_child.parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        const ParserNodeType m_child;
+        const std::shared_ptr<const char> m_token;
+        const void* const m_id;
+
+        template <class ParseContextType, class EntryType> static bool replay(ParseContextType& pc, const EntryType& entry) {
+            //add the errors the way the child did: each committed error was committed while it was the uncommitted one
+            if (entry.commitsPriorError()) {
+                pc.commitErrors();
+            }
+            for (size_t index = 0; index < entry.errors().size(); ++index) {
+                const auto& error = entry.errors()[index];
+                pc.addError(error.position(), [&]() { return error; });
+                if (index < entry.committedErrorCount()) {
+                    pc.commitErrors();
+                }
+            }
+            if (entry.success()) {
+                pc.addMatches(entry.matches().begin(), entry.matches().end());
+            }
+            pc.setSourcePosition(entry.endPosition());
+            return entry.success();
+        }
+    };
+
+
+    /**
+     * Creates a memoized parser.
+     * @param parser the parser to memoize.
+     * @return a memoized parser.
+     */
+    template <class ParserNodeType> MemoParser<ParserNodeType> memo(const ParserNode<ParserNodeType>& parser) {
+        return MemoParser<ParserNodeType>(static_cast<const ParserNodeType&>(parser));
+    }
+
+
+    /**
+     * Creates a memoized reference to a rule.
+     * All the memoized references to a rule share the results of the rule.
+     * @param rule the rule to memoize.
+     * @return a memoized parser.
+     */
+    template <class ParseContextType> MemoParser<RuleReference<ParseContextType>> memo(const Rule<ParseContextType>& rule) {
+        return MemoParser<RuleReference<ParseContextType>>(RuleReference<ParseContextType>(rule), rule.this_());
+    }
+
+
+    /**
+     * Computes the first set of a memoized parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const MemoParser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_MEMOPARSER_HPP
@@ -0,0 +1,204 @@
+#ifndef PARSERLIB_MEMOTABLE_HPP
+#define PARSERLIB_MEMOTABLE_HPP
+
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Error.hpp"
+#include "Skipper.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * The result of a memoized parser at a source position.
+     * @param PositionType source position type.
+     * @param MatchType match type.
+     */
+    template <class PositionType, class MatchType> class MemoEntry {
+    public:
+        /**
+         * Constructor.
+         * @param success the result of the parser.
+         * @param endPosition the source position after the parser.
+         * @param matches the matches added by the parser.
+         * @param errors the errors added by the parser; the committed ones come first.
+         * @param committedErrorCount number of errors the parser committed.
+         * @param commitsPriorError true if the parser committed the uncommitted error it was invoked with.
+         */
+        MemoEntry(bool success, const PositionType& endPosition, std::vector<MatchType>&& matches,
+            std::vector<Error<PositionType>>&& errors, size_t committedErrorCount, bool commitsPriorError)
+            : m_success(success), m_endPosition(endPosition), m_matches(std::move(matches)), m_errors(std::move(errors))
+            , m_committedErrorCount(committedErrorCount), m_commitsPriorError(commitsPriorError)
+        {
+        }
+
+        /**
+         * Returns the result of the parser.
+         * @return the result of the parser.
+         */
+        bool success() const {
+            return m_success;
+        }
+
+        /**
+         * Returns the source position after the parser.
+         * @return the source position after the parser.
+         */
+        const PositionType& endPosition() const {
+            return m_endPosition;
+        }
+
+        /**
+         * Returns the matches added by the parser.
+         * @return the matches added by the parser.
+         */
+        const std::vector<MatchType>& matches() const {
+            return m_matches;
+        }
+
+        /**
+         * Returns the errors added by the parser; the committed ones come first,
+         * and there is at most one uncommitted error, the last one.
+         * @return the errors added by the parser.
+         */
+        const std::vector<Error<PositionType>>& errors() const {
+            return m_errors;
+        }
+
+        /**
+         * Returns the number of errors the parser committed.
+         * @return the number of errors the parser committed.
+         */
+        size_t committedErrorCount() const {
+            return m_committedErrorCount;
+        }
+
+        /**
+         * Checks if the parser committed the uncommitted error it was invoked with.
+         * @return true if the parser committed the uncommitted error it was invoked with, false otherwise.
+         */
+        bool commitsPriorError() const {
+            return m_commitsPriorError;
+        }
+
+    private:
+        bool m_success;
+        PositionType m_endPosition;
+        std::vector<MatchType> m_matches;
+        std::vector<Error<PositionType>> m_errors;
+        size_t m_committedErrorCount;
+        bool m_commitsPriorError;
+    };
+
+
+    /**
+     * Key of the result of a memoized parser: the parser, the source offset and the skipper.
+     */
+    struct MemoKey {
+        /**
+         * Id of the parser.
+         */
+        const void* parser;
+
+        /**
+         * Source offset.
+         */
+        size_t offset;
+
+        /**
+         * Skipper.
+         */
+        const Skipper* skipper;
+
+        /**
+         * Compares two keys.
+         * @param other the other key.
+         * @return true if the keys are equal, false otherwise.
+         */
+        bool operator == (const MemoKey& other) const {
+            return parser == other.parser && offset == other.offset && skipper == other.skipper;
+        }
+    };
+
+
+    /**
+     * Hash function for memo keys.
+     */
+    struct MemoKeyHash {
+        /**
+         * Computes the hash of a key.
+         * @param key the key.
+         * @return the hash of the key.
+         */
+        size_t operator ()(const MemoKey& key) const {
+            size_t result = std::hash<const void*>()(key.parser);
+            result ^= std::hash<size_t>()(key.offset) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+            result ^= std::hash<const void*>()(key.skipper) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+            return result;
+        }
+    };
+
+
+    /**
+     * Table of results of memoized parsers, by parser, source offset and skipper.
+     * @param PositionType source position type.
+     * @param MatchType match type.
+     */
+    template <class PositionType, class MatchType> class MemoTable {
+    public:
+        /**
+         * Entry type.
+         */
+        using EntryType = MemoEntry<PositionType, MatchType>;
+
+        /**
+         * Returns the result of a parser at a source offset.
+         * @param parser id of the parser.
+         * @param offset source offset.
+         * @param skipper current skipper.
+         * @return pointer to the entry, or null if the result is not stored.
+         */
+        const EntryType* find(const void* parser, size_t offset, const Skipper* skipper) const {
+            const auto it = m_entries.find(MemoKey{ parser, offset, skipper });
+            return it != m_entries.end() ? &it->second : nullptr;
+        }
+
+        /**
+         * Stores the result of a parser at a source offset.
+         * @param parser id of the parser.
+         * @param offset source offset.
+         * @param skipper current skipper.
+         * @param entry the result.
+         */
+        void insert(const void* parser, size_t offset, const Skipper* skipper, EntryType&& entry) {
+            m_entries.insert_or_assign(MemoKey{ parser, offset, skipper }, std::move(entry));
+        }
+
+        /**
+         * Returns the number of stored results.
+         * @return the number of stored results.
+         */
+        size_t size() const {
+            return m_entries.size();
+        }
+
+        /**
+         * Removes all results.
+         */
+        void clear() {
+            m_entries.clear();
+        }
+
+    private:
+        std::unordered_map<MemoKey, EntryType, MemoKeyHash> m_entries;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_MEMOTABLE_HPP
@@ -0,0 +1,420 @@
+#ifndef PARSERLIB_NUMBERPARSER_HPP
+#define PARSERLIB_NUMBERPARSER_HPP
+
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <charconv>
+#include <type_traits>
+#include "ValueMatchParser.hpp"
+#include "util.hpp"
+#include "Error.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that parses a decimal integer and converts it to a value in one pass.
+     * An optional '-' sign is accepted for signed types.
+     * Parsing fails if the integer does not fit in the given type.
+     *
+     * For contiguous character sources, digits are converted 8 at a time (SWAR).
+     *
+     * @param T integer type.
+     */
+    template <class T> class IntegerNumberParser
+        : public ValueParserNode<IntegerNumberParser<T>> {
+    public:
+        static_assert(std::is_integral_v<T>, "T must be an integral type.");
+
+        /**
+         * Parses an integer.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses an integer; on success, it places the integer in the given value.
+         * @param pc parse context.
+         * @param value the result value; signed integers are stored as 'long long', unsigned integers as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            return pc.parseAfterSkip([&]() {
+                if (pc.sourceEnded()) {
+                    return false;
+                }
+
+                auto it = pc.sourcePosition().iterator();
+                const auto end = pc.sourceEnd();
+
+                //sign
+                bool negative = false;
+                if constexpr (std::is_signed_v<T>) {
+                    if (*it == '-') {
+                        negative = true;
+                        ++it;
+                    }
+                }
+
+                //digits
+                const auto digitsBegin = it;
+                unsigned long long magnitude = 0;
+                bool overflow = false;
+                parseDigits(it, end, magnitude, overflow);
+
+                //no digits
+                if (it == digitsBegin) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), toString("Syntax error: expected integer, found: ", *pc.sourcePosition().iterator()));
+                        });
+                    return false;
+                }
+
+                //range check
+                if (!overflow) {
+                    if constexpr (std::is_signed_v<T>) {
+                        const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+                        if (magnitude <= limit) {
+                            //negate via magnitude - 1, in order to avoid overflow for the min value
+                            value = negative && magnitude ? -static_cast<long long>(magnitude - 1) - 1 : static_cast<long long>(magnitude);
+                        }
+                        else {
+                            overflow = true;
+                        }
+                    }
+                    else {
+                        if (magnitude <= static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+                            value = magnitude;
+                        }
+                        else {
+                            overflow = true;
+                        }
+                    }
+                }
+
+                if (overflow) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: integer overflow");
+                        });
+                    return false;
+                }
+
+                pc.increaseSourcePosition(static_cast<size_t>(std::distance(pc.sourcePosition().iterator(), it)));
+                return true;
+                });
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        //consumes decimal digits, accumulating them into the given value
+        template <class Iterator> static void parseDigits(Iterator& it, const Iterator& end, unsigned long long& value, bool& overflow) {
+            constexpr unsigned long long maxValue = std::numeric_limits<unsigned long long>::max();
+
+            #ifdef PARSERLIB_LITTLE_ENDIAN
+            if constexpr (hasContiguousSegments<Iterator>() && sizeof(typename std::iterator_traits<Iterator>::value_type) == 1) {
+                while (contiguousSize(it, end) >= 8) {
+                    std::uint64_t chunk;
+                    std::memcpy(&chunk, toPointer(it), sizeof(chunk));
+                    if (!isEightDigits(chunk)) {
+                        break;
+                    }
+                    const unsigned long long chunkValue = eightDigitsValue(chunk);
+                    if (value > (maxValue - chunkValue) / 100000000ULL) {
+                        overflow = true;
+                    }
+                    value = value * 100000000ULL + chunkValue;
+                    it += 8;
+                }
+            }
+            #endif
+
+            for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+                const unsigned digit = static_cast<unsigned>(*it - '0');
+                if (value > (maxValue - digit) / 10) {
+                    overflow = true;
+                }
+                value = value * 10 + digit;
+            }
+        }
+
+        //checks if the 8 bytes of the given chunk are all decimal digits
+        static bool isEightDigits(std::uint64_t chunk) {
+            return (((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+        }
+
+        //converts 8 decimal digits, stored in little endian order, to a value
+        static std::uint32_t eightDigitsValue(std::uint64_t chunk) {
+            chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+            chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+            return static_cast<std::uint32_t>(((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+        }
+    };
+
+
+    /**
+     * A parser that parses a hexadecimal integer (without prefix) and converts it to a value in one pass.
+     * Both lowercase and uppercase digits are accepted.
+     * Parsing fails if the integer does not fit in the given type.
+     * @param T unsigned integer type.
+     */
+    template <class T> class HexNumberParser
+        : public ValueParserNode<HexNumberParser<T>> {
+    public:
+        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "T must be an unsigned integral type.");
+
+        /**
+         * Parses a hexadecimal integer.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses a hexadecimal integer; on success, it places the integer in the given value.
+         * @param pc parse context.
+         * @param value the result value; stored as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            return pc.parseAfterSkip([&]() {
+                if (pc.sourceEnded()) {
+                    return false;
+                }
+
+                auto it = pc.sourcePosition().iterator();
+                const auto end = pc.sourceEnd();
+                unsigned long long result = 0;
+                bool overflow = false;
+
+                for (; it != end; ++it) {
+                    const int digit = hexDigitValue(*it);
+                    if (digit < 0) {
+                        break;
+                    }
+                    if (result > (static_cast<unsigned long long>(std::numeric_limits<T>::max()) >> 4)) {
+                        overflow = true;
+                    }
+                    result = (result << 4) | static_cast<unsigned>(digit);
+                }
+
+                //no digits
+                if (it == pc.sourcePosition().iterator()) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), toString("Syntax error: expected hexadecimal integer, found: ", *pc.sourcePosition().iterator()));
+                        });
+                    return false;
+                }
+
+                if (overflow) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: integer overflow");
+                        });
+                    return false;
+                }
+
+                value = result;
+                pc.increaseSourcePosition(static_cast<size_t>(std::distance(pc.sourcePosition().iterator(), it)));
+                return true;
+                });
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        template <class E> static int hexDigitValue(const E& e) {
+            if (e >= '0' && e <= '9') {
+                return static_cast<int>(e - '0');
+            }
+            if (e >= 'a' && e <= 'f') {
+                return static_cast<int>(e - 'a') + 10;
+            }
+            if (e >= 'A' && e <= 'F') {
+                return static_cast<int>(e - 'A') + 10;
+            }
+            return -1;
+        }
+    };
+
+
+    /**
+     * A parser that parses a floating point number and converts it to a value in one pass.
+     * The accepted syntax is: ['-'] digits ['.' digits] [('e' | 'E') ['+' | '-'] digits],
+     * where at least one digit must exist before or after the decimal point.
+     * Conversion is done via std::from_chars; parsing fails if the number is out of range for the given type.
+     * @param T floating point type.
+     */
+    template <class T> class FloatNumberParser
+        : public ValueParserNode<FloatNumberParser<T>> {
+    public:
+        static_assert(std::is_floating_point_v<T>, "T must be a floating point type.");
+
+        /**
+         * Parses a floating point number.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Parses a floating point number; on success, it places the number in the given value.
+         * @param pc parse context.
+         * @param value the result value; stored as 'double'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            return pc.parseAfterSkip([&]() {
+                if (pc.sourceEnded()) {
+                    return false;
+                }
+
+                const auto begin = pc.sourcePosition().iterator();
+                const auto end = pc.sourceEnd();
+                auto it = begin;
+
+                //sign
+                if (*it == '-') {
+                    ++it;
+                }
+
+                //mantissa
+                size_t digitCount = skipDigits(it, end);
+                if (it != end && *it == '.') {
+                    ++it;
+                    digitCount += skipDigits(it, end);
+                }
+
+                //no digits
+                if (!digitCount) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), toString("Syntax error: expected number, found: ", *pc.sourcePosition().iterator()));
+                        });
+                    return false;
+                }
+
+                //exponent; consumed only if followed by digits
+                if (it != end && (*it == 'e' || *it == 'E')) {
+                    auto expIt = std::next(it);
+                    if (expIt != end && (*expIt == '+' || *expIt == '-')) {
+                        ++expIt;
+                    }
+                    if (skipDigits(expIt, end)) {
+                        it = expIt;
+                    }
+                }
+
+                //convert
+                const size_t length = static_cast<size_t>(std::distance(begin, it));
+                T result;
+                std::errc ec;
+                using Iterator = std::decay_t<decltype(begin)>;
+                if constexpr (isContiguousIterator<Iterator>() && std::is_same_v<typename std::iterator_traits<Iterator>::value_type, char>) {
+                    const char* str = toPointer(begin);
+                    ec = std::from_chars(str, str + length, result).ec;
+                }
+                else {
+                    std::string str(length, '\0');
+                    std::transform(begin, it, str.begin(), [](const auto& e) { return static_cast<char>(e); });
+                    ec = std::from_chars(str.data(), str.data() + length, result).ec;
+                }
+
+                if (ec != std::errc()) {
+                    pc.addError(pc.sourcePosition(), [&]() {
+                        return makeError(ErrorType::SyntaxError, pc.sourcePosition(), "Syntax error: number out of range");
+                        });
+                    return false;
+                }
+
+                value = static_cast<double>(result);
+                pc.increaseSourcePosition(length);
+                return true;
+                });
+        }
+
+        /**
+         * Does nothing; a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        template <class Iterator> static size_t skipDigits(Iterator& it, const Iterator& end) {
+            size_t count = 0;
+            for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+                ++count;
+            }
+            return count;
+        }
+    };
+
+
+    /**
+     * Creates a decimal integer parser.
+     * @param T integer type.
+     * @return a decimal integer parser.
+     */
+    template <class T = int> IntegerNumberParser<T> integerNumber() {
+        return {};
+    }
+
+
+    /**
+     * Creates a hexadecimal integer parser.
+     * @param T unsigned integer type.
+     * @return a hexadecimal integer parser.
+     */
+    template <class T = unsigned> HexNumberParser<T> hexNumber() {
+        return {};
+    }
+
+
+    /**
+     * Creates a floating point number parser.
+     * @param T floating point type.
+     * @return a floating point number parser.
+     */
+    template <class T = double> FloatNumberParser<T> floatNumber() {
+        return {};
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_NUMBERPARSER_HPP
@@ -0,0 +1,177 @@
+#ifndef PARSERLIB_PADDEDSOURCE_HPP
+#define PARSERLIB_PADDEDSOURCE_HPP
+
+
+#include <cstddef>
+#include <string_view>
+
+
+namespace parserlib {
+
+
+    /**
+     * A non-owning source over a buffer that is followed by zero elements (sentinels).
+     *
+     * The caller guarantees that the 'Padding' elements after the end of the buffer are readable and zero.
+     * Terminal parsers use this guarantee to compare without checking for the end of the source first,
+     * since a non-zero value cannot match a sentinel; string terminals compare 8 bytes at a time,
+     * even near the end of the source.
+     * @param Padding number of zero elements after the end of the buffer; it must be at least 8 for
+     *  string terminals to be compared 8 bytes at a time.
+     * @param CharT character type.
+     */
+    template <size_t Padding = 16, class CharT = char> class PaddedSource {
+    public:
+        static_assert(Padding > 0, "The padding of a padded source must not be empty.");
+
+        /**
+         * Number of zero elements after the end of the buffer.
+         */
+        static constexpr size_t padding = Padding;
+
+        /**
+         * Value type.
+         */
+        using value_type = CharT;
+
+        /**
+         * Size type.
+         */
+        using size_type = size_t;
+
+        /**
+         * Iterator type.
+         */
+        using const_iterator = const CharT*;
+
+        /**
+         * Iterator type; same as const_iterator, since the source is immutable.
+         */
+        using iterator = const_iterator;
+
+        /**
+         * The default constructor; the source is empty.
+         */
+        PaddedSource() : m_data(emptyData()), m_size(0) {
+        }
+
+        /**
+         * Constructor.
+         * @param data the buffer; 'Padding' zero elements must be readable after its end.
+         * @param size number of elements of the buffer, excluding the padding.
+         */
+        PaddedSource(const CharT* data, size_t size) : m_data(data), m_size(size) {
+        }
+
+        /**
+         * Returns the buffer.
+         * @return the buffer.
+         */
+        const CharT* data() const {
+            return m_data;
+        }
+
+        /**
+         * Returns the number of elements, excluding the padding.
+         * @return the number of elements.
+         */
+        size_t size() const {
+            return m_size;
+        }
+
+        /**
+         * Checks if the source is empty.
+         * @return true if the source is empty, false otherwise.
+         */
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        /**
+         * Returns an iterator to the first element.
+         * @return an iterator to the first element.
+         */
+        const_iterator begin() const {
+            return m_data;
+        }
+
+        /**
+         * Returns an iterator after the last element.
+         * @return an iterator after the last element.
+         */
+        const_iterator end() const {
+            return m_data + m_size;
+        }
+
+        /**
+         * Returns an element.
+         * @param index index of the element; it may be up to 'size() + Padding - 1'.
+         * @return the element.
+         */
+        const CharT& operator [](size_t index) const {
+            return m_data[index];
+        }
+
+        /**
+         * Returns a string view over the elements, excluding the padding.
+         * @return a string view over the elements.
+         */
+        std::basic_string_view<CharT> view() const {
+            return std::basic_string_view<CharT>(m_data, m_size);
+        }
+
+        /**
+         * Compares the elements of the source with a string.
+         * @param source the source.
+         * @param str the string.
+         * @return true if equal, false otherwise.
+         */
+        friend bool operator == (const PaddedSource& source, std::basic_string_view<CharT> str) {
+            return source.view() == str;
+        }
+
+        /**
+         * Compares the elements of the source with a string.
+         * @param source the source.
+         * @param str the string.
+         * @return true if different, false otherwise.
+         */
+        friend bool operator != (const PaddedSource& source, std::basic_string_view<CharT> str) {
+            return source.view() != str;
+        }
+
+        /**
+         * Compares the elements of two sources.
+         * @param a the first source.
+         * @param b the second source.
+         * @return true if equal, false otherwise.
+         */
+        friend bool operator == (const PaddedSource& a, const PaddedSource& b) {
+            return a.view() == b.view();
+        }
+
+        /**
+         * Compares the elements of two sources.
+         * @param a the first source.
+         * @param b the second source.
+         * @return true if different, false otherwise.
+         */
+        friend bool operator != (const PaddedSource& a, const PaddedSource& b) {
+            return a.view() != b.view();
+        }
+
+    private:
+        const CharT* m_data;
+        size_t m_size;
+
+        static const CharT* emptyData() {
+            static const CharT zeros[Padding] = {};
+            return zeros;
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_PADDEDSOURCE_HPP
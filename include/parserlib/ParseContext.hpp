@@ -5,12 +5,18 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <algorithm>
+#include <iterator>
 #include "Match.hpp"
 #include "TreeMatchException.hpp"
 #include "RuleState.hpp"
 #include "SourcePosition.hpp"
 #include "LineCountingSourcePosition.hpp"
 #include "Error.hpp"
+#include "Skipper.hpp"
+#include "MemoTable.hpp"
+#include "SharedMemoTable.hpp"
 
 
 namespace parserlib {
@@ -66,6 +72,16 @@ namespace parserlib {
          */
         using MatchType = Match<SourceType, MatchIdType, PositionType>;
 
+        /**
+         * Memo table type.
+         */
+        using MemoTableType = MemoTable<PositionType, MatchType>;
+
+        /**
+         * Shared memo table type.
+         */
+        using SharedMemoTableType = SharedMemoTable<PositionType, MatchType>;
+
         /**
          * Current parser state. 
          */
@@ -107,13 +123,150 @@ namespace parserlib {
             friend ThisType;
         };
 
+        /**
+         * An immutable copy of the results of a parse context at a specific point,
+         * from which many contexts can be forked, in parallel if needed.
+         */
+        class Snapshot {
+        public:
+            /**
+             * Returns the offset of the source position the snapshot was taken at.
+             * @return the offset of the source position the snapshot was taken at.
+             */
+            size_t sourceOffset() const {
+                return m_sourceOffset;
+            }
+
+            /**
+             * Returns the source position the snapshot was taken at; its iterators refer to the source of the snapshot.
+             * @return the source position the snapshot was taken at.
+             */
+            const PositionType& sourcePosition() const {
+                return m_sourcePosition;
+            }
+
+            /**
+             * Returns the matches at the time the snapshot was taken.
+             * @return the matches at the time the snapshot was taken.
+             */
+            const std::vector<MatchType>& matches() const {
+                return m_matches;
+            }
+
+            /**
+             * Returns the errors at the time the snapshot was taken.
+             * @return the errors at the time the snapshot was taken.
+             */
+            const ErrorContainer<PositionType>& errors() const {
+                return m_errors;
+            }
+
+            /**
+             * Returns the skipper at the time the snapshot was taken.
+             * @return the skipper at the time the snapshot was taken.
+             */
+            const Skipper* skipper() const {
+                return m_skipper;
+            }
+
+        private:
+            const size_t m_sourceOffset;
+            const PositionType m_sourcePosition;
+            const std::vector<MatchType> m_matches;
+            const ErrorContainer<PositionType> m_errors;
+            const Skipper* const m_skipper;
+
+            //constructor
+            Snapshot(size_t sourceOffset, const PositionType& sourcePosition, const std::vector<MatchType>& matches, const ErrorContainer<PositionType>& errors, const Skipper* skipper)
+                : m_sourceOffset(sourceOffset), m_sourcePosition(sourcePosition), m_matches(matches), m_errors(errors), m_skipper(skipper)
+            {
+            }
+
+            friend ThisType;
+        };
+
         /**
          * Constructor.
          * @param src source.
          */
         ParseContext(const SourceType& src)
-            : m_sourcePosition(src.begin(), src.end())
+            : m_sourceBegin(src.begin())
+            , m_sourcePosition(src.begin(), src.end())
+        {
+        }
+
+        /**
+         * Constructor that forks a context from a snapshot.
+         * The new context starts at the snapshot's source position, rebased on the given source, with no matches and errors of its own;
+         * the prefix of the source is not parsed again, and therefore forking does not depend on the length of the prefix;
+         * the matches and errors of the snapshot are shared, and available via parentSnapshot().
+         * Matches of the snapshot refer to the source the snapshot was taken from,
+         * which must outlive their use.
+         * @param src source; it must contain the same data as the snapshot's source, up to the snapshot's source offset.
+         * @param snapshot snapshot to fork the context from.
+         */
+        ParseContext(const SourceType& src, const std::shared_ptr<const Snapshot>& snapshot)
+            : ParseContext(src)
         {
+            m_snapshot = snapshot;
+            m_skipper = snapshot->skipper();
+            m_sourcePosition = snapshot->sourcePosition();
+            m_sourcePosition.rebase(std::next(src.begin(), static_cast<std::ptrdiff_t>(snapshot->sourceOffset())), src.end());
+        }
+
+        /**
+         * Resets the context, so as that it can be used to parse another source.
+         * Matches, errors, rule states, memoized results and the snapshot the context was forked from are cleared,
+         * and the shared memo table is detached; the memory of containers is kept,
+         * so as that parsing many small sources with one context does not allocate per source.
+         * The skipper is kept.
+         * @param src source.
+         */
+        void reset(const SourceType& src) {
+            m_sourceBegin = src.begin();
+            m_sourcePosition = PositionType(src.begin(), src.end());
+            m_snapshot.reset();
+            m_matches.clear();
+            for (auto& [rule, ruleState] : m_ruleStates) {
+                ruleState = RuleStateType(PositionType(src.end(), src.end()));
+            }
+            m_errors.clear();
+            m_committedErrorCount = 0;
+            m_skipCacheSkipper = nullptr;
+            m_memoTable.clear();
+            m_sharedMemoTable.reset();
+        }
+
+        /**
+         * Creates a snapshot of the current results: the current source offset, the matches and the errors.
+         * The snapshot is immutable, and therefore it can be shared between threads,
+         * in order to fork contexts from it.
+         * If this context was itself forked from a snapshot, then the results of that snapshot are included.
+         * It shall be invoked between parses, when no rule is being parsed.
+         * @return a snapshot of the current results.
+         */
+        std::shared_ptr<const Snapshot> snapshot() const {
+            const size_t sourceOffset = static_cast<size_t>(std::distance(m_sourceBegin, m_sourcePosition.iterator()));
+            if (!m_snapshot) {
+                return std::shared_ptr<const Snapshot>(new Snapshot(sourceOffset, m_sourcePosition, m_matches, m_errors, m_skipper));
+            }
+            std::vector<MatchType> matches;
+            matches.reserve(m_snapshot->matches().size() + m_matches.size());
+            std::copy(m_snapshot->matches().begin(), m_snapshot->matches().end(), std::back_inserter(matches));
+            std::copy(m_matches.begin(), m_matches.end(), std::back_inserter(matches));
+            ErrorContainer<PositionType> errors;
+            errors.reserve(m_snapshot->errors().size() + m_errors.size());
+            std::copy(m_snapshot->errors().begin(), m_snapshot->errors().end(), std::back_inserter(errors));
+            std::copy(m_errors.begin(), m_errors.end(), std::back_inserter(errors));
+            return std::shared_ptr<const Snapshot>(new Snapshot(sourceOffset, m_sourcePosition, matches, errors, m_skipper));
+        }
+
+        /**
+         * Returns the snapshot this context was forked from.
+         * @return the snapshot this context was forked from; null if the context was not forked from a snapshot.
+         */
+        const std::shared_ptr<const Snapshot>& parentSnapshot() const {
+            return m_snapshot;
         }
 
         /**
@@ -197,11 +350,100 @@ namespace parserlib {
             m_sourcePosition.increase(count);
         }
 
+        /**
+         * Sets the source position; the matches are not modified.
+         * @param position the new source position; it must be a position within the source of this context.
+         */
+        void setSourcePosition(const PositionType& position) {
+            m_sourcePosition = position;
+        }
+
+        /**
+         * Returns the current skipper.
+         * @return the current skipper; null if there is no skipper.
+         */
+        const Skipper* skipper() const {
+            return m_skipper;
+        }
+
+        /**
+         * Sets the skipper that is invoked before tokens are parsed.
+         * @param skipper the skipper; it must outlive its usage by this context; if null, then skipping is disabled.
+         */
+        void setSkipper(const Skipper* skipper) {
+            m_skipper = skipper;
+        }
+
+        /**
+         * Invokes the current skipper, if there is one, at the current source position.
+         * The result of the last skip is cached, so as that each position is skipped at most once
+         * while backtracking.
+         */
+        void skip() {
+            if (!m_skipper) {
+                return;
+            }
+            const auto it = m_sourcePosition.iterator();
+            if (m_skipCacheSkipper != m_skipper || it != m_skipFrom) {
+                m_skipFrom = it;
+                m_skipTo = m_skipper->skip(it, m_sourcePosition.end());
+                m_skipCacheSkipper = m_skipper;
+            }
+            if (m_skipTo != it) {
+                m_sourcePosition.increase(static_cast<size_t>(std::distance(it, m_skipTo)));
+            }
+        }
+
+        /**
+         * Invokes a function at the current source position, after skipping;
+         * if the function fails, then the source position before skipping is restored,
+         * so as that a failed parser does not consume the input skipped in front of it.
+         * @param func function to invoke.
+         * @return the result of the function.
+         */
+        template <class F> bool parseAfterSkip(const F& func) {
+            if (!m_skipper) {
+                return func();
+            }
+            const PositionType position = m_sourcePosition;
+            skip();
+            if (func()) {
+                return true;
+            }
+            m_sourcePosition = position;
+            return false;
+        }
+
+        /**
+         * Invokes a function at the current source position, after skipping, then restores the source position;
+         * used for lookahead.
+         * @param func function to invoke.
+         * @return the result of the function.
+         */
+        template <class F> bool peek(const F& func) {
+            if (!m_skipper) {
+                return func();
+            }
+            const PositionType position = m_sourcePosition;
+            skip();
+            const bool result = func();
+            m_sourcePosition = position;
+            return result;
+        }
+
+        /**
+         * Returns the beginning of the source.
+         * @return the beginning of the source.
+         */
+        const SourceIterator<SourceType>& sourceBegin() const {
+            return m_sourceBegin;
+        }
+
         /**
          * Returns the end of the source.
          * @return the end of the source.
          */
-        const typename SourceType::const_iterator& sourceEnd() const {
+        const SourceIterator<SourceType>& sourceEnd() const {
             return m_sourcePosition.end();
         }
 
@@ -221,6 +463,23 @@ namespace parserlib {
             return m_matches;
         }
 
+        /**
+         * Removes all matches; the memory of the match container is kept.
+         * It shall be invoked between parses, when no parser state refers to the matches,
+         * e.g. after the matches of a top-level parse are stored elsewhere.
+         */
+        void clearMatches() {
+            m_matches.clear();
+        }
+
+        /**
+         * Reserves room for additional matches.
+         * @param count number of additional matches.
+         */
+        void reserveMatches(size_t count) {
+            m_matches.reserve(m_matches.size() + count);
+        }
+
         /**
          * Adds a match.
          * @param id match id.
@@ -231,6 +490,26 @@ namespace parserlib {
             m_matches.push_back(MatchType(id, begin, end));
         }
 
+        /**
+         * Adds a match that carries a value.
+         * @param id match id.
+         * @param begin begin position into the source.
+         * @param end end position into the source.
+         * @param value value of the match.
+         */
+        void addMatch(const MatchIdType& id, const PositionType& begin, const PositionType& end, const MatchValue& value) {
+            m_matches.push_back(MatchType(id, begin, end, value));
+        }
+
+        /**
+         * Adds copies of matches; used for replaying the results of memoized parsers.
+         * @param begin start of the range of matches.
+         * @param end end of the range of matches.
+         */
+        template <class It> void addMatches(It begin, It end) {
+            m_matches.insert(m_matches.end(), begin, end);
+        }
+
         /**
          * Adds a match, moving the given number of matches to children.
          * @param id match id.
@@ -243,7 +522,7 @@ namespace parserlib {
             if (childCount > m_matches.size()) {
                 throw TreeMatchException<ThisType>(*this);
             }
-            MatchType m(id, begin, end, std::vector<MatchType>(m_matches.end() - childCount, m_matches.end()));
+            MatchType m(id, begin, end, std::vector<MatchType>(std::make_move_iterator(m_matches.end() - childCount), std::make_move_iterator(m_matches.end())));
             m_matches.resize(m_matches.size() - childCount);
             m_matches.push_back(std::move(m));
         }
@@ -332,6 +611,15 @@ namespace parserlib {
             }
         }
 
+        /**
+         * Returns the number of committed errors; committed errors are the first ones,
+         * and they are not removed when the error state is restored.
+         * @return the number of committed errors.
+         */
+        size_t committedErrorCount() const {
+            return m_committedErrorCount;
+        }
+
         /**
          * Commits the current set of errors.
          */
@@ -339,12 +627,71 @@ namespace parserlib {
             m_committedErrorCount = m_errors.size();
         }
 
+        /**
+         * Removes all errors, including committed ones; the memory of the error container is kept.
+         * It shall be invoked between parses, e.g. after the errors of a top-level parse are reported.
+         */
+        void clearErrors() {
+            m_errors.clear();
+            m_committedErrorCount = 0;
+        }
+
+        /**
+         * Returns the table of results of memoized parsers.
+         * @return the table of results of memoized parsers.
+         */
+        MemoTableType& memoTable() {
+            return m_memoTable;
+        }
+
+        /**
+         * Returns the memo table shared with other contexts.
+         * @return the shared memo table; null if there is none.
+         */
+        const std::shared_ptr<SharedMemoTableType>& sharedMemoTable() const {
+            return m_sharedMemoTable;
+        }
+
+        /**
+         * Sets the memo table shared with other contexts, e.g. with contexts of other threads that parse other regions of the same source;
+         * if set, memoized parsers store and replay their results via the shared table, instead of via the table of this context.
+         * @param table the shared memo table; null to use the table of this context.
+         */
+        void setSharedMemoTable(const std::shared_ptr<SharedMemoTableType>& table) {
+            m_sharedMemoTable = table;
+        }
+
+        /**
+         * Returns the number of times left recursion was detected;
+         * the results of parsers that detected left recursion depend on the rules being parsed, and therefore they are not memoized.
+         * @return the number of times left recursion was detected.
+         */
+        size_t leftRecursionCount() const {
+            return m_leftRecursionCount;
+        }
+
+        /**
+         * Increments the number of times left recursion was detected.
+         */
+        void incrementLeftRecursionCount() {
+            ++m_leftRecursionCount;
+        }
+
     private:
+        SourceIterator<SourceType> m_sourceBegin;
         PositionType m_sourcePosition;
+        std::shared_ptr<const Snapshot> m_snapshot;
         std::vector<MatchType> m_matches;
         std::map<const RuleType*, RuleStateType> m_ruleStates;
         ErrorContainer<PositionType> m_errors;
         size_t m_committedErrorCount{ 0 };
+        const Skipper* m_skipper{ nullptr };
+        const Skipper* m_skipCacheSkipper{ nullptr };
+        SourceIterator<SourceType> m_skipFrom;
+        SourceIterator<SourceType> m_skipTo;
+        MemoTableType m_memoTable;
+        std::shared_ptr<SharedMemoTableType> m_sharedMemoTable;
+        size_t m_leftRecursionCount{ 0 };
     };
 
 
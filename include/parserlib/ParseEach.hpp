@@ -0,0 +1,295 @@
+#ifndef PARSERLIB_PARSEEACH_HPP
+#define PARSERLIB_PARSEEACH_HPP
+
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "ParseContext.hpp"
+#include "Rule.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A lazy range over the top-level items of a source, e.g. over the rules of a grammar that is a repetition of rules.
+     *
+     * Items are parsed one at a time, when the range is iterated; the matches and errors of an item
+     * are cleared before the next item is parsed, along with the memoized results,
+     * so the memory used for them is bounded by one item rather than by the whole source.
+     *
+     * Iteration stops at the end of the source, after an item that fails, or when an item succeeds without advancing;
+     * a failed item is yielded, with the errors that explain the failure.
+     *
+     * The source and the range must outlive the iteration; the range may be copied or moved before iteration,
+     * or between iterations, but iterators refer to the range they were obtained from.
+     * The item parser is copied, except for rules, which are referenced, and therefore they must outlive the range.
+     * @param ParseContextType type of parse context.
+     * @param ParserType type of the item parser.
+     */
+    template <class ParseContextType, class ParserType> class ParseEachRange {
+    public:
+        /**
+         * Match type.
+         */
+        using MatchType = typename ParseContextType::MatchType;
+
+        /**
+         * Position type.
+         */
+        using PositionType = typename ParseContextType::PositionType;
+
+        /**
+         * A parsed item; its contents are valid until the next item is parsed.
+         */
+        class Item {
+        public:
+            /**
+             * Checks if the item was parsed successfully.
+             * @return true if the item was parsed successfully, false otherwise.
+             */
+            bool success() const {
+                return m_success;
+            }
+
+            /**
+             * Returns the position the item begins at.
+             * @return the begin position.
+             */
+            const PositionType& begin() const {
+                return m_begin;
+            }
+
+            /**
+             * Returns the position the item ends at.
+             * @return the end position; for a failed item, it is the position parsing stopped at.
+             */
+            const PositionType& end() const {
+                return m_end;
+            }
+
+            /**
+             * Returns the top-level matches of the item.
+             * @return the top-level matches of the item.
+             */
+            const std::vector<MatchType>& matches() const {
+                return m_pc->matches();
+            }
+
+            /**
+             * Returns the errors of the item; for a successful item, only the committed errors are kept.
+             * @return the errors of the item.
+             */
+            const ErrorContainer<PositionType>& errors() const {
+                return m_pc->errors();
+            }
+
+        private:
+            const ParseContextType* m_pc{ nullptr };
+            bool m_success{ false };
+            PositionType m_begin;
+            PositionType m_end;
+
+            friend ParseEachRange;
+        };
+
+        /**
+         * Input iterator over the items; incrementing it parses the next item.
+         */
+        class Iterator {
+        public:
+            /**
+             * Iterator category.
+             */
+            using iterator_category = std::input_iterator_tag;
+
+            /**
+             * Value type.
+             */
+            using value_type = Item;
+
+            /**
+             * Difference type.
+             */
+            using difference_type = std::ptrdiff_t;
+
+            /**
+             * Pointer type.
+             */
+            using pointer = const Item*;
+
+            /**
+             * Reference type.
+             */
+            using reference = const Item&;
+
+            /**
+             * Returns the current item.
+             * @return the current item.
+             */
+            const Item& operator *() const {
+                return m_range->m_item;
+            }
+
+            /**
+             * Returns a pointer to the current item.
+             * @return a pointer to the current item.
+             */
+            const Item* operator ->() const {
+                return &m_range->m_item;
+            }
+
+            /**
+             * Parses the next item.
+             * @return reference to this.
+             */
+            Iterator& operator ++() {
+                m_range->parseNext();
+                return *this;
+            }
+
+            /**
+             * Checks if two iterators are equal; iterators are equal if they are both at the end of the range.
+             * @param other the other iterator.
+             * @return true if the iterators are equal, false otherwise.
+             */
+            bool operator == (const Iterator& other) const {
+                return atEnd() == other.atEnd();
+            }
+
+            /**
+             * Checks if two iterators are different.
+             * @param other the other iterator.
+             * @return true if the iterators are different, false otherwise.
+             */
+            bool operator != (const Iterator& other) const {
+                return !operator == (other);
+            }
+
+        private:
+            ParseEachRange* m_range;
+
+            Iterator(ParseEachRange* range) : m_range(range) {
+            }
+
+            bool atEnd() const {
+                return !m_range || m_range->m_ended;
+            }
+
+            friend ParseEachRange;
+        };
+
+        /**
+         * Constructor.
+         * @param parser the item parser.
+         * @param source the source; it must outlive the range.
+         */
+        ParseEachRange(const ParserType& parser, const typename ParseContextType::SourceType& source)
+            : m_parser(parser), m_pc(source)
+        {
+        }
+
+        /**
+         * Returns an iterator to the first item; the first invocation parses the first item.
+         * @return an iterator to the current item.
+         */
+        Iterator begin() {
+            //the range may have been copied or moved since the item was last parsed
+            m_item.m_pc = &m_pc;
+            if (!m_started) {
+                m_started = true;
+                parseNext();
+            }
+            return Iterator(this);
+        }
+
+        /**
+         * Returns the end iterator.
+         * @return the end iterator.
+         */
+        Iterator end() {
+            return Iterator(nullptr);
+        }
+
+        /**
+         * Returns the parse context; after iteration, its position is where parsing stopped.
+         * @return the parse context.
+         */
+        const ParseContextType& parseContext() const {
+            return m_pc;
+        }
+
+    private:
+        const ParserType m_parser;
+        ParseContextType m_pc;
+        Item m_item;
+        bool m_started{ false };
+        bool m_stopped{ false };
+        bool m_ended{ false };
+
+        void parseNext() {
+            m_item.m_pc = &m_pc;
+            m_pc.clearMatches();
+            m_pc.clearErrors();
+            m_pc.memoTable().clear();
+
+            if (m_stopped || m_pc.sourceEnded()) {
+                m_ended = true;
+                return;
+            }
+
+            const auto begin = m_pc.sourcePosition();
+            const auto errorState = m_pc.errorState();
+            const bool success = m_parser(m_pc);
+
+            if (success) {
+                //errors of alternatives that failed while the item succeeded are not errors of the item
+                m_pc.setErrorState(errorState);
+                if (m_pc.sourcePosition() == begin) {
+                    m_pc.clearMatches();
+                    m_ended = true;
+                    return;
+                }
+            }
+            else {
+                m_stopped = true;
+            }
+
+            m_item.m_success = success;
+            m_item.m_begin = begin;
+            m_item.m_end = m_pc.sourcePosition();
+        }
+    };
+
+
+    /**
+     * Creates a lazy range over the top-level items of a source.
+     *
+     * Example: 'for (const auto& item : parseEach(parser, source)) { ... item.matches() ... }'.
+     * @param parser the item parser.
+     * @param source the source; it must outlive the range.
+     * @return a range over the parsed items.
+     */
+    template <class ParseContextType = ParseContext<>, class ParserNodeType>
+    ParseEachRange<ParseContextType, ParserNodeType> parseEach(const ParserNode<ParserNodeType>& parser, const typename ParseContextType::SourceType& source) {
+        return ParseEachRange<ParseContextType, ParserNodeType>(static_cast<const ParserNodeType&>(parser), source);
+    }
+
+
+    /**
+     * Creates a lazy range over the top-level items of a source, each one parsed by a rule.
+     * @param rule the item rule; it must outlive the range.
+     * @param source the source; it must outlive the range.
+     * @return a range over the parsed items.
+     */
+    template <class ParseContextType>
+    ParseEachRange<ParseContextType, RuleReference<ParseContextType>> parseEach(const Rule<ParseContextType>& rule, const typename ParseContextType::SourceType& source) {
+        return ParseEachRange<ParseContextType, RuleReference<ParseContextType>>(RuleReference<ParseContextType>(rule), source);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_PARSEEACH_HPP
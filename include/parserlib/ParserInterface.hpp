@@ -2,6 +2,9 @@
 #define PARSERLIB_PARSERINTERFACE_HPP
 
 
+#include "FirstSet.hpp"
+
+
 namespace parserlib {
 
 
@@ -32,6 +35,15 @@ namespace parserlib {
          * @return true if parsing succeeds, false otherwise.
          */
         virtual bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const = 0;
+
+        /**
+         * Computes the first set of the parser.
+         * @param context first set context.
+         * @return the first set of the parser; by default, a full, nullable set.
+         */
+        virtual FirstSet firstSet(FirstSetContext& /*context*/) const {
+            return FirstSet::all();
+        }
     };
 
 
@@ -2,6 +2,8 @@
 #define PARSERLIB_PARSERNODE_HPP
 
 
+#include <type_traits>
+#include <utility>
 #include "LeftRecursionContext.hpp"
 
 
@@ -25,6 +27,24 @@ namespace parserlib {
     };
 
 
+    /**
+     * Trait that checks if a parser node can peek, i.e. if it provides the function 'peek(pc)',
+     * which returns the result of parsing at the current position, without changing the parse context
+     * (other than the skip cache) and without adding errors or matches.
+     * Lookahead parsers (e.g. the not parser) use it instead of parsing and restoring the state of the parse context.
+     * @param ParserNodeType type of parser node.
+     * @param ParseContextType type of parse context.
+     */
+    template <class ParserNodeType, class ParseContextType, class = void> struct CanPeek : std::false_type {
+    };
+
+
+    template <class ParserNodeType, class ParseContextType>
+    struct CanPeek<ParserNodeType, ParseContextType, std::void_t<decltype(std::declval<const ParserNodeType&>().peek(std::declval<ParseContextType&>()))>>
+        : std::true_type {
+    };
+
+
 } //namespace parserlib
 
 
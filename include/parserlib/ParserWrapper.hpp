@@ -52,6 +52,15 @@ namespace parserlib {
             return m_parser.parseLeftRecursionContinuation(pc, lrc);
         }
 
+        /**
+         * Computes the first set of the wrapped parser.
+         * @param context first set context.
+         * @return the first set of the wrapped parser.
+         */
+        FirstSet firstSet(FirstSetContext& context) const override {
+            return computeFirstSet(m_parser, context);
+        }
+
     private:
         const ParserNodeType m_parser;
     };
@@ -0,0 +1,834 @@
+#ifndef PARSERLIB_PREDICTIVEPARSER_HPP
+#define PARSERLIB_PREDICTIVEPARSER_HPP
+
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "ParserNode.hpp"
+#include "SequenceParser.hpp"
+#include "ChoiceParser.hpp"
+#include "Loop0Parser.hpp"
+#include "Loop1Parser.hpp"
+#include "OptionalParser.hpp"
+#include "MatchParser.hpp"
+#include "TreeMatchParser.hpp"
+#include "EOFParser.hpp"
+#include "FirstSet.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * Result of the analysis of a predictive parser.
+     */
+    class PredictiveCertificate {
+    public:
+        /**
+         * Constructor.
+         * @param caseSensitive if true, the analysis is case sensitive, otherwise it is case insensitive.
+         */
+        PredictiveCertificate(bool caseSensitive = true) : m_caseSensitive(caseSensitive) {
+        }
+
+        /**
+         * Checks if the analysis is case sensitive.
+         * @return true if the analysis is case sensitive, false otherwise.
+         */
+        bool caseSensitive() const {
+            return m_caseSensitive;
+        }
+
+        /**
+         * Returns the number of decisions (choices, loops, optionals) that are taken by one element of lookahead.
+         * @return the number of predictive decisions.
+         */
+        size_t predictiveCount() const {
+            return m_predictiveCount;
+        }
+
+        /**
+         * Returns the number of predictive decisions that keep a checkpoint, because the elements that may follow them
+         * are unknown or overlap with the elements they start with.
+         * @return the number of guarded decisions.
+         */
+        size_t guardedCount() const {
+            return m_guardedCount;
+        }
+
+        /**
+         * Returns the number of decisions that cannot be taken by one element of lookahead and therefore backtrack.
+         * @return the number of backtracking decisions.
+         */
+        size_t backtrackingCount() const {
+            return m_backtrackingCount;
+        }
+
+        /**
+         * Checks if the parser is certified as LL(1), i.e. if all its decisions are taken by one element of lookahead,
+         * without checkpoints.
+         * @return true if the parser is certified, false otherwise.
+         */
+        bool certified() const {
+            return m_guardedCount == 0 && m_backtrackingCount == 0;
+        }
+
+        /**
+         * Records a decision.
+         * @param predictive true if the decision is taken by lookahead.
+         * @param guarded true if the decision keeps a checkpoint.
+         */
+        void addDecision(bool predictive, bool guarded) {
+            if (!predictive) {
+                ++m_backtrackingCount;
+                return;
+            }
+            ++m_predictiveCount;
+            if (guarded) {
+                ++m_guardedCount;
+            }
+        }
+
+    private:
+        bool m_caseSensitive;
+        size_t m_predictiveCount{ 0 };
+        size_t m_guardedCount{ 0 };
+        size_t m_backtrackingCount{ 0 };
+    };
+
+
+    /**
+     * Analyzes a parser that takes no decisions; it does nothing.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser; it is nullable if that is unknown.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ParserNodeType> void analyzePredictive(const ParserNode<ParserNodeType>& /*parser*/, const FirstSet& /*follow*/, PredictiveCertificate& /*certificate*/) {
+    }
+
+
+    /**
+     * Returns the first set a parser contributes to the follow set of the parser before it in a sequence;
+     * the end of the source, which is not a value, is represented by an empty, non-nullable set.
+     * @param parser the parser.
+     * @param caseSensitive if true, the first set is computed case sensitively, otherwise case insensitively.
+     * @return the first set of the parser.
+     */
+    template <class ParserNodeType> FirstSet followFirstSet(const ParserNodeType& parser, bool caseSensitive) {
+        if constexpr (std::is_same_v<ParserNodeType, EOFParser>) {
+            return FirstSet();
+        }
+        else {
+            return firstSet(parser, caseSensitive);
+        }
+    }
+
+
+    //invokes a function with the current element, after skipping, and returns its result; returns the given value at the end of the source
+    template <class ParseContextType, class F> size_t lookahead(ParseContextType& pc, size_t endResult, const F& func) {
+        size_t result = endResult;
+        pc.peek([&]() {
+            if (!pc.sourceEnded()) {
+                result = func(*pc.sourcePosition().iterator());
+            }
+            return true;
+        });
+        return result;
+    }
+
+
+    /**
+     * A sequence within a predictive parser; it does not keep a checkpoint,
+     * since its failure is handled by the nearest enclosing checkpoint, i.e. the one of the predictive parser,
+     * or of a decision that could not be taken by lookahead alone.
+     * @param Children children parser nodes.
+     */
+    template <class ...Children> class PredictiveSequenceParser : public ParserNode<PredictiveSequenceParser<Children...>> {
+    public:
+        /**
+         * Constructor.
+         * @param children children nodes.
+         */
+        PredictiveSequenceParser(const std::tuple<Children...>& children) : m_children(children) {
+        }
+
+        /**
+         * Returns the children nodes.
+         * @return the children nodes.
+         */
+        const std::tuple<Children...>& children() const {
+            return m_children;
+        }
+
+        /**
+         * Analyzes the children, from the last one to the first one.
+         * @param follow the first set of what may follow the sequence.
+         * @param certificate the certificate to record decisions to.
+         */
+        void analyze(const FirstSet& follow, PredictiveCertificate& certificate) const {
+            analyzeChildren<sizeof...(Children)>(follow, certificate);
+        }
+
+        /**
+         * Invokes all child parsers, one by one, until one returns false.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return std::apply([&](const auto&... children) { return (children(pc) && ...); }, m_children);
+        }
+
+        /**
+         * Parses the sequence as a left recursion continuation; it keeps a checkpoint.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return SequenceParser<Children...>(m_children).parseLeftRecursionContinuation(pc, lrc);
+        }
+
+    private:
+        std::tuple<Children...> m_children;
+
+        template <size_t Count> void analyzeChildren(const FirstSet& follow, PredictiveCertificate& certificate) const {
+            if constexpr (Count > 0) {
+                const auto& child = std::get<Count - 1>(m_children);
+                analyzePredictive(child, follow, certificate);
+
+                //the follow set of the previous child is the first set of this child, plus this child's follow set if it is nullable
+                FirstSet childFollow = followFirstSet(child, certificate.caseSensitive());
+                if (childFollow.nullable()) {
+                    childFollow.addValues(follow);
+                    childFollow.setNullable(follow.nullable());
+                }
+                analyzeChildren<Count - 1>(childFollow, certificate);
+            }
+        }
+    };
+
+
+    /**
+     * A choice within a predictive parser.
+     *
+     * If no alternative is nullable, except maybe the last one, and the first sets of the alternatives are disjoint,
+     * the alternative is selected by the current element, and only that alternative is tried.
+     * If the last alternative is nullable and the elements that may follow the choice are unknown or overlap with the
+     * elements the other alternatives start with, the selected alternative is tried with a checkpoint,
+     * and the last alternative is tried if it fails, as in a choice.
+     * Otherwise, the alternatives are tried in order, each one with a checkpoint.
+     * @param Children children parser nodes.
+     */
+    template <class ...Children> class PredictiveChoiceParser : public ParserNode<PredictiveChoiceParser<Children...>> {
+    public:
+        /**
+         * Constructor.
+         * @param children children nodes.
+         */
+        PredictiveChoiceParser(const std::tuple<Children...>& children) : m_children(children), m_analysis(std::make_shared<Analysis>()) {
+        }
+
+        /**
+         * Returns the children nodes.
+         * @return the children nodes.
+         */
+        const std::tuple<Children...>& children() const {
+            return m_children;
+        }
+
+        /**
+         * Computes the dispatch table of the choice and analyzes the children.
+         * @param follow the first set of what may follow the choice.
+         * @param certificate the certificate to record decisions to.
+         */
+        void analyze(const FirstSet& follow, PredictiveCertificate& certificate) const {
+            Analysis& analysis = *m_analysis;
+            analysis.firstSets.clear();
+            std::apply([&](const auto&... children) { (analysis.firstSets.push_back(firstSet(children, certificate.caseSensitive())), ...); }, m_children);
+
+            analysis.predictive = sizeof...(Children) < std::numeric_limits<unsigned char>::max();
+            analysis.table.fill(None);
+            FirstSet nonNullableSet;
+            for (size_t index = 0; index < analysis.firstSets.size() && analysis.predictive; ++index) {
+                const FirstSet& firstSet = analysis.firstSets[index];
+                if (firstSet.nullable()) {
+                    if (index + 1 < analysis.firstSets.size()) {
+                        analysis.predictive = false;
+                    }
+                    analysis.nullableIndex = index;
+                }
+                else {
+                    nonNullableSet.addValues(firstSet);
+                }
+                for (size_t value = 0; value < analysis.table.size(); ++value) {
+                    if (firstSet.contains(static_cast<unsigned char>(value))) {
+                        if (analysis.table[value] != None) {
+                            analysis.predictive = false;
+                        }
+                        analysis.table[value] = static_cast<unsigned char>(index);
+                    }
+                }
+            }
+            analysis.guarded = analysis.nullableIndex != None && (follow.nullable() || nonNullableSet.intersects(follow));
+            certificate.addDecision(analysis.predictive, analysis.guarded);
+
+            //the failure of an alternative tried with a checkpoint must be the same as without lookahead
+            const FirstSet childFollow = analysis.predictive && !analysis.guarded ? follow : FirstSet::all();
+            std::apply([&](const auto&... children) { (analyzePredictive(children, childFollow, certificate), ...); }, m_children);
+        }
+
+        /**
+         * Invokes the alternative selected by the current element, or the alternatives one by one, if the choice is not predictive.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            const Analysis& analysis = *m_analysis;
+            if (!analysis.predictive) {
+                return parseBacktracking(pc, [&](const auto& child) { return child(pc); });
+            }
+
+            const size_t index = lookahead(pc, analysis.nullableIndex, [&](const auto& value) { return alternative(value); });
+
+            //no alternative can parse the current element; parse all of them in order to report the errors
+            if (index == None) {
+                return parseBacktracking(pc, [&](const auto& child) { return child(pc); });
+            }
+
+            if (!analysis.guarded || index == analysis.nullableIndex) {
+                return parseChild<0>(index, pc);
+            }
+
+            //the selected alternative may fail where the nullable alternative succeeds
+            const auto state = pc.state();
+            const auto errorState = pc.errorState();
+            if (parseChild<0>(index, pc)) {
+                return true;
+            }
+            pc.setState(state);
+            if (parseChild<0>(analysis.nullableIndex, pc)) {
+                pc.setErrorState(errorState);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Invokes the alternatives one by one, as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return parseBacktracking(pc, [&](const auto& child) { return child.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        static constexpr size_t None = std::numeric_limits<unsigned char>::max();
+
+        struct Analysis {
+            std::vector<FirstSet> firstSets;
+            std::array<unsigned char, 256> table{};
+            size_t nullableIndex{ None };
+            bool predictive{ false };
+            bool guarded{ false };
+        };
+
+        std::tuple<Children...> m_children;
+        std::shared_ptr<Analysis> m_analysis;
+
+        template <class T> size_t alternative(const T& value) const {
+            const Analysis& analysis = *m_analysis;
+            if constexpr (sizeof(T) == 1) {
+                const size_t index = analysis.table[static_cast<unsigned char>(value)];
+                return index != None ? index : analysis.nullableIndex;
+            }
+            else {
+                for (size_t index = 0; index < analysis.firstSets.size(); ++index) {
+                    if (analysis.firstSets[index].containsValue(value)) {
+                        return index;
+                    }
+                }
+                return analysis.nullableIndex;
+            }
+        }
+
+        template <class ParseContextType, class PF> bool parseBacktracking(ParseContextType& pc, const PF& pf) const {
+            const auto errorState = pc.errorState();
+            const bool result = std::apply([&](const auto&... children) {
+                return ([&](const auto& child) {
+                    const auto state = pc.state();
+                    if (pf(child)) {
+                        return true;
+                    }
+                    pc.setState(state);
+                    return false;
+                }(children) || ...);
+            }, m_children);
+            if (result) {
+                pc.setErrorState(errorState);
+            }
+            return result;
+        }
+
+        template <size_t Index, class ParseContextType> bool parseChild(size_t index, ParseContextType& pc) const {
+            if constexpr (Index < sizeof...(Children)) {
+                if (index == Index) {
+                    return std::get<Index>(m_children)(pc);
+                }
+                return parseChild<Index + 1>(index, pc);
+            }
+            else {
+                return false;
+            }
+        }
+    };
+
+
+    /**
+     * A loop or an optional within a predictive parser.
+     *
+     * If the child is not nullable, then it is invoked only when the current element is in its first set,
+     * and, if the elements that may follow the loop are known and do not overlap with its first set, without a checkpoint.
+     * Otherwise, each iteration keeps a checkpoint, as in a loop.
+     * @param ParserNodeType type of child.
+     * @param MinCount min number of iterations; 0 or 1.
+     * @param MaxCount max number of iterations; 1 for optionals.
+     */
+    template <class ParserNodeType, size_t MinCount, size_t MaxCount> class PredictiveLoopParser : public ParserNode<PredictiveLoopParser<ParserNodeType, MinCount, MaxCount>> {
+    public:
+        /**
+         * Constructor.
+         * @param child child parser.
+         */
+        PredictiveLoopParser(const ParserNodeType& child) : m_child(child), m_analysis(std::make_shared<Analysis>()) {
+        }
+
+        /**
+         * Returns the child parser.
+         * @return the child parser.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Computes the first set of the child and analyzes it.
+         * @param follow the first set of what may follow the loop.
+         * @param certificate the certificate to record decisions to.
+         */
+        void analyze(const FirstSet& follow, PredictiveCertificate& certificate) const {
+            Analysis& analysis = *m_analysis;
+            analysis.firstSet = firstSet(m_child, certificate.caseSensitive());
+            analysis.predictive = !analysis.firstSet.nullable();
+            analysis.guarded = follow.nullable() || analysis.firstSet.intersects(follow);
+            certificate.addDecision(analysis.predictive, analysis.guarded);
+
+            //in a loop, the child may be followed by itself;
+            //the failure of a child parsed with a checkpoint must be the same as without lookahead
+            FirstSet childFollow = analysis.predictive && !analysis.guarded ? follow : FirstSet::all();
+            if (MaxCount > 1) {
+                childFollow.addValues(analysis.firstSet);
+            }
+            analyzePredictive(m_child, childFollow, certificate);
+        }
+
+        /**
+         * Invokes the child parser while the current element is in its first set.
+         * @param pc parse context.
+         * @return true if the min number of iterations is parsed, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return parse(pc, [&]() { return m_child(pc); });
+        }
+
+        /**
+         * Invokes the child parser as a left recursion continuation, then in a loop.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if the min number of iterations is parsed, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return parse(pc, [&]() { return m_child.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        struct Analysis {
+            FirstSet firstSet;
+            bool predictive{ false };
+            bool guarded{ false };
+        };
+
+        const ParserNodeType m_child;
+        std::shared_ptr<Analysis> m_analysis;
+
+        template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
+            const Analysis& analysis = *m_analysis;
+            const auto errorState = pc.errorState();
+            for (size_t count = 0; count < MaxCount; ++count) {
+                //if the child cannot start at the current element, the loop ends
+                const bool required = count < MinCount;
+                if (analysis.predictive && !required && lookahead(pc, 0, [&](const auto& value) { return analysis.firstSet.containsValue(value); }) == 0) {
+                    break;
+                }
+
+                const auto state = pc.state();
+                const bool result = count == 0 ? pf() : m_child(pc);
+
+                //without a checkpoint, the failure of the child is the failure of the predictive parser
+                if (!result) {
+                    if (required) {
+                        return false;
+                    }
+                    if (analysis.predictive && !analysis.guarded) {
+                        return false;
+                    }
+                    pc.setState(state);
+                    break;
+                }
+
+                //if no advance was made, stop in order to avoid an infinite loop
+                if (pc.sourcePosition() == state.sourcePosition()) {
+                    break;
+                }
+            }
+            pc.setErrorState(errorState);
+            return true;
+        }
+    };
+
+
+    /**
+     * Analyzes a predictive node.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ...Children> void analyzePredictive(const PredictiveSequenceParser<Children...>& parser, const FirstSet& follow, PredictiveCertificate& certificate) {
+        parser.analyze(follow, certificate);
+    }
+
+
+    /**
+     * Analyzes a predictive node.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ...Children> void analyzePredictive(const PredictiveChoiceParser<Children...>& parser, const FirstSet& follow, PredictiveCertificate& certificate) {
+        parser.analyze(follow, certificate);
+    }
+
+
+    /**
+     * Analyzes a predictive node.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ParserNodeType, size_t MinCount, size_t MaxCount>
+    void analyzePredictive(const PredictiveLoopParser<ParserNodeType, MinCount, MaxCount>& parser, const FirstSet& follow, PredictiveCertificate& certificate) {
+        parser.analyze(follow, certificate);
+    }
+
+
+    /**
+     * Analyzes the child of a match parser.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ParserNodeType, class MatchIdType> void analyzePredictive(const MatchParser<ParserNodeType, MatchIdType>& parser, const FirstSet& follow, PredictiveCertificate& certificate) {
+        analyzePredictive(parser.child(), follow, certificate);
+    }
+
+
+    /**
+     * Analyzes the child of a tree match parser.
+     * @param parser the parser.
+     * @param follow the first set of what may follow the parser.
+     * @param certificate the certificate to record decisions to.
+     */
+    template <class ParserNodeType, class MatchIdType> void analyzePredictive(const TreeMatchParser<ParserNodeType, MatchIdType>& parser, const FirstSet& follow, PredictiveCertificate& certificate) {
+        analyzePredictive(parser.child(), follow, certificate);
+    }
+
+
+    /**
+     * Converts a parser that takes no decisions to a predictive parser; it returns the parser itself.
+     * Rules are also returned as they are; they can be made predictive separately.
+     * @param parser the parser.
+     * @return the parser.
+     */
+    template <class ParserNodeType> ParserNodeType toPredictive(const ParserNode<ParserNodeType>& parser) {
+        return static_cast<const ParserNodeType&>(parser);
+    }
+
+
+    /**
+     * Converts a sequence to a predictive sequence.
+     * @param parser the parser.
+     * @return a predictive sequence.
+     */
+    template <class ...Children> auto toPredictive(const SequenceParser<Children...>& parser) {
+        return std::apply([](const auto&... children) {
+            return PredictiveSequenceParser<decltype(toPredictive(children))...>(std::make_tuple(toPredictive(children)...));
+        }, parser.children());
+    }
+
+
+    /**
+     * Converts a choice to a predictive choice.
+     * @param parser the parser.
+     * @return a predictive choice.
+     */
+    template <class ...Children> auto toPredictive(const ChoiceParser<Children...>& parser) {
+        return std::apply([](const auto&... children) {
+            return PredictiveChoiceParser<decltype(toPredictive(children))...>(std::make_tuple(toPredictive(children)...));
+        }, parser.children());
+    }
+
+
+    /**
+     * Converts a loop to a predictive loop.
+     * @param parser the parser.
+     * @return a predictive loop.
+     */
+    template <class ParserNodeType> auto toPredictive(const Loop0Parser<ParserNodeType>& parser) {
+        return PredictiveLoopParser<decltype(toPredictive(parser.child())), 0, std::numeric_limits<size_t>::max()>(toPredictive(parser.child()));
+    }
+
+
+    /**
+     * Converts a loop to a predictive loop.
+     * @param parser the parser.
+     * @return a predictive loop.
+     */
+    template <class ParserNodeType> auto toPredictive(const Loop1Parser<ParserNodeType>& parser) {
+        return PredictiveLoopParser<decltype(toPredictive(parser.child())), 1, std::numeric_limits<size_t>::max()>(toPredictive(parser.child()));
+    }
+
+
+    /**
+     * Converts an optional to a predictive optional.
+     * @param parser the parser.
+     * @return a predictive optional.
+     */
+    template <class ParserNodeType> auto toPredictive(const OptionalParser<ParserNodeType>& parser) {
+        return PredictiveLoopParser<decltype(toPredictive(parser.child())), 0, 1>(toPredictive(parser.child()));
+    }
+
+
+    /**
+     * Converts the child of a match parser.
+     * @param parser the parser.
+     * @return a match parser with a predictive child.
+     */
+    template <class ParserNodeType, class MatchIdType> auto toPredictive(const MatchParser<ParserNodeType, MatchIdType>& parser) {
+        return MatchParser<decltype(toPredictive(parser.child())), MatchIdType>(toPredictive(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * Converts the child of a tree match parser.
+     * @param parser the parser.
+     * @return a tree match parser with a predictive child.
+     */
+    template <class ParserNodeType, class MatchIdType> auto toPredictive(const TreeMatchParser<ParserNodeType, MatchIdType>& parser) {
+        return TreeMatchParser<decltype(toPredictive(parser.child())), MatchIdType>(toPredictive(parser.child()), parser.matchId());
+    }
+
+
+    /**
+     * A parser that takes its decisions by one element of lookahead, where the grammar allows it.
+     *
+     * On the first parse, the grammar is analyzed: choices whose alternatives start with different elements,
+     * loops and optionals are resolved by the current element, instead of trying each alternative and backtracking.
+     * Sequences within the parser keep no checkpoint; the parser keeps one checkpoint, which it restores if it fails.
+     * Decisions that the analysis cannot resolve by lookahead keep checkpoints and backtrack, as usual.
+     *
+     * If the certificate of the parser says it is certified, then parsing is a single forward pass.
+     * The elements that may follow the parser are unknown, unless it ends with 'eof()';
+     * therefore loops and optionals at the end of a parser that does not end with 'eof()' keep a checkpoint.
+     * Rules are not analyzed; they can be made predictive separately.
+     *
+     * The analysis is case sensitive or not, as the source positions of the parse context of the first parse;
+     * in parse contexts of the other case mode, the given parser is invoked instead, i.e. parsing backtracks as usual.
+     *
+     * The result, the source position and the matches are the same as without lookahead;
+     * when parsing fails, the errors may be different.
+     * @param ParserNodeType the type of parser to make predictive.
+     */
+    template <class ParserNodeType> class PredictiveParser : public ParserNode<PredictiveParser<ParserNodeType>> {
+    public:
+        /**
+         * Type of the predictive child.
+         */
+        using ChildType = decltype(toPredictive(std::declval<const ParserNodeType&>()));
+
+        /**
+         * Constructor.
+         * @param child the parser to make predictive.
+         */
+        PredictiveParser(const ParserNodeType& child) : m_original(child), m_child(toPredictive(child)), m_analysis(std::make_shared<Analysis>()) {
+        }
+
+        /**
+         * Returns the given parser.
+         * @return the given parser.
+         */
+        const ParserNodeType& original() const {
+            return m_original;
+        }
+
+        /**
+         * Returns the predictive child.
+         * @return the predictive child.
+         */
+        const ChildType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Returns the result of the analysis of the parser; the analysis takes place once.
+         * @param caseSensitive the case mode of the analysis, if it has not taken place yet.
+         * @return the certificate of the parser.
+         */
+        const PredictiveCertificate& certificate(bool caseSensitive = true) const {
+            std::call_once(m_analysis->flag, [&]() {
+                m_analysis->certificate = PredictiveCertificate(caseSensitive);
+                analyzePredictive(m_child, FirstSet::all(), m_analysis->certificate);
+            });
+            return m_analysis->certificate;
+        }
+
+        /**
+         * Checks if the parser is certified as LL(1), i.e. if parsing is a single forward pass.
+         * @param caseSensitive the case mode of the analysis, if it has not taken place yet.
+         * @return true if the parser is certified, false otherwise.
+         */
+        bool certified(bool caseSensitive = true) const {
+            return certificate(caseSensitive).certified();
+        }
+
+        /**
+         * Invokes the predictive child.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            if (!analyzed(pc)) {
+                return m_original(pc);
+            }
+            return parse(pc, [&]() { return m_child(pc); });
+        }
+
+        /**
+         * Invokes the predictive child as a left recursion continuation.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            if (!analyzed(pc)) {
+                return m_original.parseLeftRecursionContinuation(pc, lrc);
+            }
+            return parse(pc, [&]() { return m_child.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        struct Analysis {
+            std::once_flag flag;
+            PredictiveCertificate certificate;
+        };
+
+        const ParserNodeType m_original;
+        const ChildType m_child;
+        std::shared_ptr<Analysis> m_analysis;
+
+        //analyzes the parser in the case mode of the parse context, if not analyzed yet; returns true if the analysis is in that mode
+        template <class ParseContextType> bool analyzed(ParseContextType& /*pc*/) const {
+            constexpr bool caseSensitive = IsCaseSensitivePosition<typename ParseContextType::PositionType>::value;
+            return certificate(caseSensitive).caseSensitive() == caseSensitive;
+        }
+
+        template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
+            const auto state = pc.state();
+            if (pf()) {
+                return true;
+            }
+            pc.setState(state);
+            return false;
+        }
+    };
+
+
+    /**
+     * Creates a parser that takes its decisions by one element of lookahead, where the grammar allows it.
+     * @param parser the parser to make predictive.
+     * @return a predictive parser.
+     */
+    template <class ParserNodeType> PredictiveParser<ParserNodeType> predictive(const ParserNode<ParserNodeType>& parser) {
+        return PredictiveParser<ParserNodeType>(static_cast<const ParserNodeType&>(parser));
+    }
+
+
+    /**
+     * Computes the first set of a predictive sequence.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the sequence.
+     */
+    template <class ...Children> FirstSet computeFirstSet(const PredictiveSequenceParser<Children...>& parser, FirstSetContext& context) {
+        return computeFirstSet(SequenceParser<Children...>(parser.children()), context);
+    }
+
+
+    /**
+     * Computes the first set of a predictive choice.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the choice.
+     */
+    template <class ...Children> FirstSet computeFirstSet(const PredictiveChoiceParser<Children...>& parser, FirstSetContext& context) {
+        return computeFirstSet(ChoiceParser<Children...>(parser.children()), context);
+    }
+
+
+    /**
+     * Computes the first set of a predictive loop or optional.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child, nullable if the loop may parse the child zero times.
+     */
+    template <class ParserNodeType, size_t MinCount, size_t MaxCount>
+    FirstSet computeFirstSet(const PredictiveLoopParser<ParserNodeType, MinCount, MaxCount>& parser, FirstSetContext& context) {
+        FirstSet result = computeFirstSet(parser.child(), context);
+        if (MinCount == 0) {
+            result.setNullable(true);
+        }
+        return result;
+    }
+
+
+    /**
+     * Computes the first set of a predictive parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType> FirstSet computeFirstSet(const PredictiveParser<ParserNodeType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_PREDICTIVEPARSER_HPP
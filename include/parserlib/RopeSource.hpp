@@ -0,0 +1,419 @@
+#ifndef PARSERLIB_ROPESOURCE_HPP
+#define PARSERLIB_ROPESOURCE_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace parserlib {
+
+
+    /**
+     * A source made of a sequence of buffers (pieces), which are not concatenated.
+     *
+     * The rope does not own the pieces; they must outlive the rope and the parse contexts that use it.
+     * The rope owns its table of pieces, and its iterators point into that table, as with std::string:
+     * iterators must not outlive the rope they were obtained from, and appending invalidates them;
+     * the content of a match is a separate rope, whose iterators are valid while that rope exists.
+     * Its iterator is random access; within a piece, it is as cheap as a pointer,
+     * and it exposes the contiguous remainder of the current piece, so as that
+     * the scanning fast paths of the library (e.g. whitespace skipping, first set search)
+     * work on each piece at a time.
+     *
+     * The iterator also provides the index of the piece and the offset within the piece,
+     * so as that match positions can be mapped back to the buffers they came from.
+     * @param CharT character type.
+     */
+    template <class CharT = char> class RopeSource {
+    private:
+        struct Piece {
+            const CharT* data;
+            size_t size;
+            size_t start;
+        };
+
+    public:
+        /**
+         * Value type.
+         */
+        using value_type = CharT;
+
+        /**
+         * Size type.
+         */
+        using size_type = size_t;
+
+        /**
+         * Piece type.
+         */
+        using PieceType = std::basic_string_view<CharT>;
+
+        /**
+         * Iterator over the elements of a rope.
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = CharT;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const CharT*;
+            using reference = const CharT&;
+
+            /**
+             * The default constructor.
+             */
+            const_iterator() {
+            }
+
+            /**
+             * Returns the index of the piece the iterator points to.
+             * @return the index of the piece; equal to the piece count for the end iterator.
+             */
+            size_t pieceIndex() const {
+                return m_piece;
+            }
+
+            /**
+             * Returns the offset of the iterator within its piece.
+             * @return the offset of the iterator within its piece.
+             */
+            size_t pieceOffset() const {
+                return static_cast<size_t>(m_ptr - m_pieces[m_piece].data);
+            }
+
+            /**
+             * Returns the offset of the iterator from the beginning of the rope.
+             * @return the offset of the iterator from the beginning of the rope.
+             */
+            size_t offset() const {
+                return m_pieces[m_piece].start + pieceOffset();
+            }
+
+            /**
+             * Returns a pointer to the current element.
+             * @return pointer to the current element.
+             */
+            const CharT* segmentData() const {
+                return m_ptr;
+            }
+
+            /**
+             * Returns the number of elements from the current one to the end of the current piece.
+             * @return the number of elements from the current one to the end of the current piece.
+             */
+            size_t segmentSize() const {
+                return static_cast<size_t>(m_pieceEnd - m_ptr);
+            }
+
+            const CharT& operator *() const {
+                return *m_ptr;
+            }
+
+            const CharT* operator ->() const {
+                return m_ptr;
+            }
+
+            const CharT& operator [](difference_type index) const {
+                return *(*this + index);
+            }
+
+            const_iterator& operator ++() {
+                if (++m_ptr == m_pieceEnd) {
+                    enterPiece(m_piece + 1);
+                }
+                return *this;
+            }
+
+            const_iterator operator ++(int) {
+                const_iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            const_iterator& operator --() {
+                if (m_ptr != m_pieces[m_piece].data) {
+                    --m_ptr;
+                }
+                else {
+                    seek(offset() - 1);
+                }
+                return *this;
+            }
+
+            const_iterator operator --(int) {
+                const_iterator result = *this;
+                --*this;
+                return result;
+            }
+
+            const_iterator& operator += (difference_type count) {
+                if (count >= 0 && count < m_pieceEnd - m_ptr) {
+                    m_ptr += count;
+                }
+                else {
+                    seek(static_cast<size_t>(static_cast<difference_type>(offset()) + count));
+                }
+                return *this;
+            }
+
+            const_iterator& operator -= (difference_type count) {
+                return *this += -count;
+            }
+
+            const_iterator operator + (difference_type count) const {
+                const_iterator result = *this;
+                result += count;
+                return result;
+            }
+
+            friend const_iterator operator + (difference_type count, const const_iterator& it) {
+                return it + count;
+            }
+
+            const_iterator operator - (difference_type count) const {
+                const_iterator result = *this;
+                result -= count;
+                return result;
+            }
+
+            difference_type operator - (const const_iterator& other) const {
+                return static_cast<difference_type>(offset()) - static_cast<difference_type>(other.offset());
+            }
+
+            bool operator == (const const_iterator& other) const {
+                return m_ptr == other.m_ptr && m_piece == other.m_piece;
+            }
+
+            bool operator != (const const_iterator& other) const {
+                return !(*this == other);
+            }
+
+            bool operator < (const const_iterator& other) const {
+                return m_piece < other.m_piece || (m_piece == other.m_piece && m_ptr < other.m_ptr);
+            }
+
+            bool operator > (const const_iterator& other) const {
+                return other < *this;
+            }
+
+            bool operator <= (const const_iterator& other) const {
+                return !(other < *this);
+            }
+
+            bool operator >= (const const_iterator& other) const {
+                return !(*this < other);
+            }
+
+        private:
+            //pieces of the rope; the last one is an empty sentinel piece that starts at the rope size
+            const Piece* m_pieces{ nullptr };
+            size_t m_pieceCount{ 0 };
+            size_t m_piece{ 0 };
+            const CharT* m_ptr{ nullptr };
+            const CharT* m_pieceEnd{ nullptr };
+
+            const_iterator(const Piece* pieces, size_t pieceCount, size_t offset)
+                : m_pieces(pieces), m_pieceCount(pieceCount)
+            {
+                seek(offset);
+            }
+
+            //positions the iterator at the first element of the first non-empty piece, starting from the given one
+            void enterPiece(size_t piece) {
+                for (; piece < m_pieceCount && m_pieces[piece].size == 0; ++piece) {
+                }
+                m_piece = piece;
+                m_ptr = m_pieces[piece].data;
+                m_pieceEnd = m_ptr + m_pieces[piece].size;
+            }
+
+            //positions the iterator at the given offset from the beginning of the rope
+            void seek(size_t offset) {
+                if (offset >= m_pieces[m_pieceCount].start) {
+                    enterPiece(m_pieceCount);
+                    return;
+                }
+                const Piece* const piece = std::upper_bound(m_pieces, m_pieces + m_pieceCount, offset, [](size_t value, const Piece& p) {
+                    return value < p.start;
+                    }) - 1;
+                m_piece = static_cast<size_t>(piece - m_pieces);
+                m_ptr = piece->data + (offset - piece->start);
+                m_pieceEnd = piece->data + piece->size;
+            }
+
+            friend class RopeSource;
+
+            //copies up to the given number of elements into a string; used for error messages
+            friend std::basic_string<CharT> toSubString(const const_iterator& begin, const const_iterator& end, size_t len) {
+                return RopeSource(begin, begin + std::min(static_cast<difference_type>(len), end - begin)).toString();
+            }
+        };
+
+        /**
+         * Iterator type; same as const_iterator, since the rope is immutable.
+         */
+        using iterator = const_iterator;
+
+        /**
+         * The default constructor; the rope is empty.
+         */
+        RopeSource() {
+            m_pieces.push_back(Piece{ nullptr, 0, 0 });
+        }
+
+        /**
+         * Constructor from pieces.
+         * @param pieces pieces.
+         */
+        RopeSource(const std::vector<PieceType>& pieces) : RopeSource() {
+            for (const PieceType& piece : pieces) {
+                append(piece);
+            }
+        }
+
+        /**
+         * Constructor from pieces.
+         * @param pieces pieces.
+         */
+        RopeSource(std::initializer_list<PieceType> pieces) : RopeSource() {
+            for (const PieceType& piece : pieces) {
+                append(piece);
+            }
+        }
+
+        /**
+         * Constructor from a range of another rope; the new rope references the same buffers.
+         * Used for the content of matches, which is therefore not copied.
+         * @param begin start of range.
+         * @param end end of range.
+         */
+        RopeSource(const const_iterator& begin, const const_iterator& end) : RopeSource() {
+            if (!(begin < end)) {
+                return;
+            }
+            for (size_t index = begin.m_piece; index <= end.m_piece && index < begin.m_pieceCount; ++index) {
+                const Piece& piece = begin.m_pieces[index];
+                const CharT* const pieceBegin = index == begin.m_piece ? begin.m_ptr : piece.data;
+                const CharT* const pieceEnd = index == end.m_piece ? end.m_ptr : piece.data + piece.size;
+                if (pieceEnd != pieceBegin) {
+                        append(PieceType(pieceBegin, static_cast<size_t>(pieceEnd - pieceBegin)));
+                }
+            }
+        }
+
+        /**
+         * Appends a piece.
+         * It invalidates all iterators of the rope.
+         * @param piece piece to append.
+         */
+        void append(const PieceType& piece) {
+            Piece& sentinel = m_pieces.back();
+            sentinel.data = piece.data();
+            sentinel.size = piece.size();
+            m_pieces.push_back(Piece{ nullptr, 0, sentinel.start + piece.size() });
+        }
+
+        /**
+         * Returns the number of elements of the rope.
+         * @return the number of elements of the rope.
+         */
+        size_t size() const {
+            return m_pieces.back().start;
+        }
+
+        /**
+         * Checks if the rope is empty.
+         * @return true if the rope is empty, false otherwise.
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Returns the number of pieces.
+         * @return the number of pieces.
+         */
+        size_t pieceCount() const {
+            return m_pieces.size() - 1;
+        }
+
+        /**
+         * Returns a piece.
+         * @param index index of the piece.
+         * @return the piece.
+         */
+        PieceType piece(size_t index) const {
+            return PieceType(m_pieces[index].data, m_pieces[index].size);
+        }
+
+        /**
+         * Returns the offset of a piece from the beginning of the rope.
+         * @param index index of the piece.
+         * @return the offset of the piece.
+         */
+        size_t pieceStart(size_t index) const {
+            return m_pieces[index].start;
+        }
+
+        /**
+         * Returns an iterator to the first element.
+         * @return an iterator to the first element.
+         */
+        const_iterator begin() const {
+            return const_iterator(m_pieces.data(), pieceCount(), 0);
+        }
+
+        /**
+         * Returns an iterator after the last element.
+         * @return an iterator after the last element.
+         */
+        const_iterator end() const {
+            return const_iterator(m_pieces.data(), pieceCount(), size());
+        }
+
+        /**
+         * Copies the elements of the rope into a string.
+         * @return a string with the elements of the rope.
+         */
+        std::basic_string<CharT> toString() const {
+            std::basic_string<CharT> result;
+            result.reserve(size());
+            for (size_t index = 0; index < pieceCount(); ++index) {
+                result.append(m_pieces[index].data, m_pieces[index].size);
+            }
+            return result;
+        }
+
+        /**
+         * Checks if two ropes have the same elements, regardless of how they are split into pieces.
+         * @param other the other rope.
+         * @return true if the ropes are equal, false otherwise.
+         */
+        bool operator == (const RopeSource& other) const {
+            return size() == other.size() && std::equal(begin(), end(), other.begin());
+        }
+
+        /**
+         * Checks if two ropes have different elements.
+         * @param other the other rope.
+         * @return true if the ropes are different, false otherwise.
+         */
+        bool operator != (const RopeSource& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        std::vector<Piece> m_pieces;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_ROPESOURCE_HPP
@@ -18,6 +18,7 @@
 #include "TreeMatchParser.hpp"
 #include "util.hpp"
 #include "ErrorParser.hpp"
+#include "SkipParser.hpp"
 
 
 namespace parserlib {
@@ -117,11 +118,18 @@ namespace parserlib {
 
         //parse
         template <class LRF> bool parse(ParseContextType& pc, const LRF& lrf) const {
+            //skip whitespace before the rule, so as that left recursion is detected at the position of the first token
+            return pc.parseAfterSkip([&]() { return parseSkipped(pc, lrf); });
+        }
+
+        //parse after skipping whitespace
+        template <class LRF> bool parseSkipped(ParseContextType& pc, const LRF& lrf) const {
             //get the state for the rule
             RuleStateType& ruleState = pc.ruleState(*this);
 
             //check if there is left recursion
             if (ruleState.position() == pc.sourcePosition()) {
+                pc.incrementLeftRecursionCount();
                 return lrf(ruleState);
             }
 
@@ -568,6 +576,37 @@ namespace parserlib {
     }
 
 
+    template <class ParseContextType>
+    auto skip(const Skipper& skipper, Rule<ParseContextType>&& rule) = delete;
+
+
+    /**
+     * Creates a parser that enables the given skipper while invoking a rule.
+     * @param skipper the skipper.
+     * @param rule rule to invoke.
+     * @return a skip parser.
+     */
+    template <class ParseContextType>
+    SkipParser<RuleReference<ParseContextType>> skip(const Skipper& skipper, const Rule<ParseContextType>& rule) {
+        return { skipper, RuleReference<ParseContextType>(rule) };
+    }
+
+
+    template <class ParseContextType>
+    auto lexeme(Rule<ParseContextType>&& rule) = delete;
+
+
+    /**
+     * Creates a parser that disables the current skipper while invoking a rule.
+     * @param rule rule to invoke.
+     * @return a lexeme parser.
+     */
+    template <class ParseContextType>
+    LexemeParser<RuleReference<ParseContextType>> lexeme(const Rule<ParseContextType>& rule) {
+        return { RuleReference<ParseContextType>(rule) };
+    }
+
+
 } //namespace parserlib
 
 
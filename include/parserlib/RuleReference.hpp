@@ -33,7 +33,7 @@ namespace parserlib {
          * Returns the rule.
          * @return the rule.
          */
-        Rule<ParseContextType>& rule() const {
+        const Rule<ParseContextType>& rule() const {
             return m_rule;
         }
 
@@ -0,0 +1,303 @@
+#ifndef PARSERLIB_SEARCH_HPP
+#define PARSERLIB_SEARCH_HPP
+
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <vector>
+#include "ParseContext.hpp"
+#include "FirstSet.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * Search mode.
+     */
+    enum class SearchMode {
+        ///after a match, the search continues from the end of the match.
+        NonOverlapping,
+
+        ///after a match, the search continues from the position after the start of the match.
+        Overlapping
+    };
+
+
+    /**
+     * A search result: the range of source a parser matched.
+     * @param PositionType source position type.
+     */
+    template <class PositionType> class SearchResult {
+    public:
+        /**
+         * Constructor.
+         * @param begin start of the match.
+         * @param end end of the match.
+         */
+        SearchResult(const PositionType& begin, const PositionType& end)
+            : m_begin(begin), m_end(end) {
+        }
+
+        /**
+         * Returns the start of the match.
+         * @return the start of the match.
+         */
+        const PositionType& begin() const {
+            return m_begin;
+        }
+
+        /**
+         * Returns the end of the match.
+         * @return the end of the match.
+         */
+        const PositionType& end() const {
+            return m_end;
+        }
+
+    private:
+        PositionType m_begin;
+        PositionType m_end;
+    };
+
+
+    /**
+     * Searches for matches of a parser, starting from the current position of a parse context,
+     * up to the given limit; the parser is tried at every candidate position.
+     *
+     * Candidate positions are found with the parser's first set: for byte sources,
+     * positions that cannot start a match are skipped with memchr or a SIMD/table scan.
+     * If the parser is nullable, every position is a candidate.
+     *
+     * Errors from failed attempts are discarded; matches added by successful attempts are kept in the context.
+     * @param parser parser or rule to search for.
+     * @param pc parse context.
+     * @param limit candidate positions are less than this; if it is the end of the source, then the end is also a candidate;
+     *  if it is not the end of the source, then the source iterators must be random access.
+     * @param mode search mode.
+     * @param onFound function invoked with the begin and end positions of each match;
+     *  it shall return true to continue searching, false to stop.
+     * @return number of matches found.
+     */
+    template <class ParseContextType, class ParserType, class F>
+    size_t searchRange(const ParserType& parser, ParseContextType& pc, const SourceIterator<typename ParseContextType::SourceType>& limit, SearchMode mode, const F& onFound) {
+        using ElementType = typename std::iterator_traits<SourceIterator<typename ParseContextType::SourceType>>::value_type;
+
+        const FirstSet candidates = firstSet(parser, IsCaseSensitivePosition<typename ParseContextType::PositionType>::value);
+        const bool prefilter = !candidates.nullable() && !candidates.isAll() && sizeof(ElementType) == 1;
+        const bool limitIsEnd = limit == pc.sourceEnd();
+        size_t count = 0;
+
+        for (;;) {
+            //a match may end past a limit that is not the end of the source
+            if (!limitIsEnd && std::distance(pc.sourcePosition().iterator(), limit) <= 0) {
+                break;
+            }
+
+            //find the next candidate position
+            if (prefilter) {
+                const auto it = pc.sourcePosition().iterator();
+                const auto found = candidates.find(it, limit);
+                if (found == limit) {
+                    break;
+                }
+                pc.increaseSourcePosition(static_cast<size_t>(std::distance(it, found)));
+            }
+            else if (pc.sourcePosition().iterator() == limit && (!limitIsEnd || !candidates.nullable())) {
+                break;
+            }
+
+            //skip whitespace before the candidate, so as that the match begins at the first token;
+            //positions past the limit are not candidates
+            if (pc.skipper()) {
+                const auto it = pc.sourcePosition().iterator();
+                const auto remaining = std::distance(it, limit);
+                pc.skip();
+                const auto skipped = std::distance(it, pc.sourcePosition().iterator());
+                if (skipped > remaining || (skipped == remaining && skipped > 0 && !limitIsEnd)) {
+                    break;
+                }
+            }
+
+            const auto state = pc.state();
+            const auto errorState = pc.errorState();
+            const auto begin = pc.sourcePosition();
+            const bool success = parser(pc);
+            pc.setErrorState(errorState);
+
+            if (success) {
+                ++count;
+                const auto end = pc.sourcePosition();
+                if (!onFound(begin, end)) {
+                    break;
+                }
+                if (mode == SearchMode::NonOverlapping && end != begin) {
+                    continue;
+                }
+                pc.setSourcePosition(begin);
+            }
+            else {
+                pc.setState(state);
+            }
+
+            //next position
+            if (pc.sourceEnded() || pc.sourcePosition().iterator() == limit) {
+                break;
+            }
+            pc.incrementSourcePosition();
+        }
+
+        return count;
+    }
+
+
+    /**
+     * Searches for all matches of a parser, starting from the current position of a parse context;
+     * the parser is tried at every candidate position, not only at the start of the source.
+     * Errors from failed attempts are discarded; matches added by successful attempts are kept in the context.
+     * @param parser parser or rule to search for.
+     * @param pc parse context.
+     * @param onFound function invoked with the begin and end positions of each match.
+     * @param mode search mode.
+     * @return number of matches found.
+     */
+    template <class ParseContextType, class ParserType, class F>
+    size_t search(const ParserType& parser, ParseContextType& pc, const F& onFound, SearchMode mode = SearchMode::NonOverlapping) {
+        return searchRange(parser, pc, pc.sourceEnd(), mode, [&](const auto& begin, const auto& end) {
+            onFound(begin, end);
+            return true;
+        });
+    }
+
+
+    /**
+     * Finds all matches of a parser in a source.
+     *
+     * If more than one thread is requested, the source is split into chunks, which are searched in parallel;
+     * then, in non-overlapping mode, the results of each chunk are resynchronized with the end of the previous match,
+     * so as that the results are the same as the results of a sequential search.
+     * @param parser parser or rule to search for.
+     * @param source the source.
+     * @param mode search mode.
+     * @param threadCount number of threads to use.
+     * @return the matches found, ordered by position.
+     */
+    template <class ParseContextType = ParseContext<>, class ParserType>
+    std::vector<SearchResult<typename ParseContextType::PositionType>>
+        findAll(const ParserType& parser, const typename ParseContextType::SourceType& source, SearchMode mode = SearchMode::NonOverlapping, size_t threadCount = 1)
+    {
+        using PositionType = typename ParseContextType::PositionType;
+        using ResultType = SearchResult<PositionType>;
+        using ResultVector = std::vector<ResultType>;
+
+        //search a range of candidate positions
+        const auto searchChunk = [&](size_t chunkBegin, size_t chunkEnd, ResultVector& results) {
+            ParseContextType pc(source);
+            pc.increaseSourcePosition(chunkBegin);
+            searchRange(parser, pc, std::next(source.begin(), chunkEnd), mode, [&](const PositionType& begin, const PositionType& end) {
+                results.push_back(ResultType(begin, end));
+                return true;
+            });
+        };
+
+        const size_t sourceSize = static_cast<size_t>(std::distance(source.begin(), source.end()));
+        const size_t chunkCount = std::max<size_t>(1, std::min(threadCount, sourceSize));
+
+        if (chunkCount == 1) {
+            ResultVector results;
+            searchChunk(0, sourceSize, results);
+            return results;
+        }
+
+        const auto offset = [&](const PositionType& position) {
+            return static_cast<size_t>(std::distance(source.begin(), position.iterator()));
+        };
+
+        //the position a non-overlapping search continues from after a match
+        const auto resumeOffset = [&](const ResultType& result) {
+            const size_t begin = offset(result.begin());
+            const size_t end = offset(result.end());
+            return end > begin ? end : begin + 1;
+        };
+
+        //search the chunks in parallel
+        std::vector<size_t> chunkBounds(chunkCount + 1);
+        for (size_t index = 0; index <= chunkCount; ++index) {
+            chunkBounds[index] = sourceSize * index / chunkCount;
+        }
+        std::vector<ResultVector> chunkResults(chunkCount);
+        std::vector<std::future<void>> futures;
+        for (size_t index = 0; index < chunkCount; ++index) {
+            futures.push_back(std::async(std::launch::async, [&, index]() {
+                searchChunk(chunkBounds[index], chunkBounds[index + 1], chunkResults[index]);
+            }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+
+        //merge the results
+        ResultVector results;
+        size_t resume = 0;
+        for (size_t index = 0; index < chunkCount; ++index) {
+            const ResultVector& chunk = chunkResults[index];
+            const size_t chunkBegin = chunkBounds[index];
+            const size_t chunkEnd = chunkBounds[index + 1];
+
+            if (mode == SearchMode::Overlapping || resume <= chunkBegin) {
+                results.insert(results.end(), chunk.begin(), chunk.end());
+            }
+            else {
+                //the first chunk match that does not start before the resume position
+                const auto first = std::find_if(chunk.begin(), chunk.end(), [&](const ResultType& result) {
+                    return offset(result.begin()) >= resume;
+                });
+
+                //if the chunk search did not skip the resume position, then its matches from there on are valid
+                if (first == chunk.begin() || resumeOffset(*std::prev(first)) <= resume) {
+                    results.insert(results.end(), first, chunk.end());
+                }
+
+                //else search again from the resume position until a match coincides with a chunk match
+                else {
+                    auto next = first;
+                    bool synchronized = false;
+                    ResultVector rescanned;
+                    ParseContextType pc(source);
+                    pc.increaseSourcePosition(resume);
+                    searchRange(parser, pc, std::next(source.begin(), chunkEnd), mode, [&](const PositionType& begin, const PositionType& end) {
+                        const size_t beginOffset = offset(begin);
+                        while (next != chunk.end() && offset(next->begin()) < beginOffset) {
+                            ++next;
+                        }
+                        if (next != chunk.end() && offset(next->begin()) == beginOffset) {
+                            synchronized = true;
+                            return false;
+                        }
+                        rescanned.push_back(ResultType(begin, end));
+                        return true;
+                    });
+                    results.insert(results.end(), rescanned.begin(), rescanned.end());
+                    if (synchronized) {
+                        results.insert(results.end(), next, chunk.end());
+                    }
+                }
+            }
+
+            if (!results.empty()) {
+                resume = std::max(chunkEnd, resumeOffset(results.back()));
+            }
+            else {
+                resume = chunkEnd;
+            }
+        }
+
+        return results;
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SEARCH_HPP
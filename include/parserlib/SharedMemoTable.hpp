@@ -0,0 +1,171 @@
+#ifndef PARSERLIB_SHAREDMEMOTABLE_HPP
+#define PARSERLIB_SHAREDMEMOTABLE_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "MemoTable.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A table of results of memoized parsers that can be shared by parse contexts of different threads,
+     * when they parse the same source, e.g. different regions of one document.
+     * A result stored by one context is replayed by the others.
+     *
+     * The table is lock-free: it has a fixed number of slots, which are filled by compare-and-swap,
+     * and stored results are immutable, until the table is cleared or destroyed.
+     * Lookups are wait-free, since they examine a bounded number of slots.
+     * Memory is bounded by the number of slots; a result is not stored if the slots it can be stored at are full,
+     * which only costs the result being computed again; the capacity should therefore be at least
+     * the number of results expected, i.e. of the memoized parsers times the source positions they are invoked at.
+     *
+     * The matches of stored results refer to the source; all contexts that share the table
+     * shall parse the same source object, with the same grammar.
+     * @param PositionType source position type.
+     * @param MatchType match type.
+     */
+    template <class PositionType, class MatchType> class SharedMemoTable {
+    public:
+        /**
+         * Entry type.
+         */
+        using EntryType = MemoEntry<PositionType, MatchType>;
+
+        /**
+         * Maximum number of slots examined for a key.
+         */
+        static constexpr size_t MaxProbeCount = 32;
+
+        /**
+         * Constructor.
+         * @param capacity maximum number of results; it is rounded up to a power of 2, of at least MaxProbeCount.
+         */
+        SharedMemoTable(size_t capacity = 1 << 16) {
+            size_t slotCount = MaxProbeCount;
+            while (slotCount < capacity) {
+                slotCount *= 2;
+            }
+            m_slots = std::make_unique<std::atomic<const Node*>[]>(slotCount);
+            m_mask = slotCount - 1;
+            for (size_t index = 0; index < slotCount; ++index) {
+                m_slots[index].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * The table is not copyable.
+         */
+        SharedMemoTable(const SharedMemoTable&) = delete;
+
+        /**
+         * The table is not copyable.
+         */
+        SharedMemoTable& operator = (const SharedMemoTable&) = delete;
+
+        /**
+         * Destructor.
+         */
+        ~SharedMemoTable() {
+            clear();
+        }
+
+        /**
+         * Returns the result of a parser at a source offset; it can be invoked concurrently with other lookups and insertions.
+         * @param parser id of the parser.
+         * @param offset source offset.
+         * @param skipper current skipper.
+         * @return pointer to the entry, or null if the result is not stored; the entry is valid until the table is cleared.
+         */
+        const EntryType* find(const void* parser, size_t offset, const Skipper* skipper) const {
+            const MemoKey key{ parser, offset, skipper };
+            size_t index = MemoKeyHash()(key);
+            for (size_t probe = 0; probe < MaxProbeCount; ++probe, ++index) {
+                const Node* const node = m_slots[index & m_mask].load(std::memory_order_acquire);
+                if (!node) {
+                    break;
+                }
+                if (node->key == key) {
+                    return &node->entry;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Stores the result of a parser at a source offset; it can be invoked concurrently with other lookups and insertions.
+         * If the result is already stored, e.g. by another thread, then the stored result is kept.
+         * @param parser id of the parser.
+         * @param offset source offset.
+         * @param skipper current skipper.
+         * @param entry the result.
+         */
+        void insert(const void* parser, size_t offset, const Skipper* skipper, EntryType&& entry) {
+            const MemoKey key{ parser, offset, skipper };
+            std::unique_ptr<Node> newNode;
+            size_t index = MemoKeyHash()(key);
+            for (size_t probe = 0; probe < MaxProbeCount; ++probe, ++index) {
+                std::atomic<const Node*>& slot = m_slots[index & m_mask];
+                const Node* node = slot.load(std::memory_order_acquire);
+                if (!node) {
+                    if (!newNode) {
+                        newNode.reset(new Node{ key, std::move(entry) });
+                    }
+                    if (slot.compare_exchange_strong(node, newNode.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        newNode.release();
+                        m_size.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                //the slot is taken; it may have been taken by the same key
+                if (node->key == key) {
+                    return;
+                }
+            }
+        }
+
+        /**
+         * Returns the number of stored results.
+         * @return the number of stored results.
+         */
+        size_t size() const {
+            return m_size.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns the maximum number of results.
+         * @return the number of slots.
+         */
+        size_t capacity() const {
+            return m_mask + 1;
+        }
+
+        /**
+         * Removes all results; it shall not be invoked while the table is used by other threads.
+         */
+        void clear() {
+            for (size_t index = 0; index <= m_mask; ++index) {
+                delete m_slots[index].exchange(nullptr, std::memory_order_relaxed);
+            }
+            m_size.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        struct Node {
+            const MemoKey key;
+            const EntryType entry;
+        };
+
+        std::unique_ptr<std::atomic<const Node*>[]> m_slots;
+        size_t m_mask;
+        std::atomic<size_t> m_size{ 0 };
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SHAREDMEMOTABLE_HPP
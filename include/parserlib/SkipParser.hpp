@@ -0,0 +1,164 @@
+#ifndef PARSERLIB_SKIPPARSER_HPP
+#define PARSERLIB_SKIPPARSER_HPP
+
+
+#include "ParserNode.hpp"
+#include "Skipper.hpp"
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that enables a skipper while invoking another parser.
+     * While the skipper is enabled, whitespace and comments are skipped before each token.
+     * @param ParserNodeType the parser to invoke.
+     */
+    template <class ParserNodeType> class SkipParser : public ParserNode<SkipParser<ParserNodeType>> {
+    public:
+        /**
+         * Constructor.
+         * @param skipper the skipper.
+         * @param child child parser to invoke.
+         */
+        SkipParser(const Skipper& skipper, const ParserNodeType& child) 
+            : m_skipper(skipper), m_child(child) {
+        }
+
+        /**
+         * Returns the skipper.
+         * @return the skipper.
+         */
+        const Skipper& skipper() const {
+            return m_skipper;
+        }
+
+        /**
+         * Returns the parser to invoke.
+         * @return the parser to invoke.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Invokes the child parser with the skipper enabled.
+         * The previous skipper is restored afterwards.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return parse(pc, [&]() { return m_child(pc); });
+        }
+
+        /**
+         * Invokes the child parser with the skipper enabled.
+         * The object is called to parse within a left recursion parsing context,
+         * in order to continue parsing after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return parse(pc, [&]() { return m_child.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        const Skipper m_skipper;
+        const ParserNodeType m_child;
+
+        template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
+            const Skipper* prevSkipper = pc.skipper();
+            const ScopeExit restoreSkipper([&]() { pc.setSkipper(prevSkipper); });
+            pc.setSkipper(&m_skipper);
+            return pf();
+        }
+    };
+
+
+    /**
+     * A parser that disables the current skipper while invoking another parser,
+     * in order to parse a lexeme (e.g. an identifier) as a contiguous sequence of tokens.
+     * Whitespace and comments are skipped before the lexeme, but not within it.
+     * @param ParserNodeType the parser to invoke.
+     */
+    template <class ParserNodeType> class LexemeParser : public ParserNode<LexemeParser<ParserNodeType>> {
+    public:
+        /**
+         * Constructor.
+         * @param child child parser to invoke.
+         */
+        LexemeParser(const ParserNodeType& child) : m_child(child) {
+        }
+
+        /**
+         * Returns the parser to invoke.
+         * @return the parser to invoke.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Invokes the child parser with the skipper disabled.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return parse(pc, [&]() { return m_child(pc); });
+        }
+
+        /**
+         * Invokes the child parser with the skipper disabled.
+         * The object is called to parse within a left recursion parsing context,
+         * in order to continue parsing after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& pc, LeftRecursionContext<ParseContextType>& lrc) const {
+            return parse(pc, [&]() { return m_child.parseLeftRecursionContinuation(pc, lrc); });
+        }
+
+    private:
+        const ParserNodeType m_child;
+
+        template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
+            return pc.parseAfterSkip([&]() {
+                const Skipper* prevSkipper = pc.skipper();
+                const ScopeExit restoreSkipper([&]() { pc.setSkipper(prevSkipper); });
+                pc.setSkipper(nullptr);
+                return pf();
+                });
+        }
+    };
+
+
+    /**
+     * Creates a parser that enables the given skipper while invoking the given parser.
+     * @param skipper the skipper.
+     * @param node the parser to invoke.
+     * @return a skip parser.
+     */
+    template <class ParserNodeType>
+    SkipParser<ParserNodeType> skip(const Skipper& skipper, const ParserNode<ParserNodeType>& node) {
+        return { skipper, static_cast<const ParserNodeType&>(node) };
+    }
+
+
+    /**
+     * Creates a parser that disables the current skipper while invoking the given parser.
+     * @param node the parser to invoke.
+     * @return a lexeme parser.
+     */
+    template <class ParserNodeType>
+    LexemeParser<ParserNodeType> lexeme(const ParserNode<ParserNodeType>& node) {
+        return { static_cast<const ParserNodeType&>(node) };
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SKIPPARSER_HPP
@@ -0,0 +1,193 @@
+#ifndef PARSERLIB_SKIPPER_HPP
+#define PARSERLIB_SKIPPER_HPP
+
+
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * Skips whitespace and comments.
+     *
+     * It recognizes a set of whitespace characters, line comments (from a start sequence up to the end of line)
+     * and block comments (from a start sequence up to an end sequence).
+     * Block comments that are not terminated are not skipped.
+     *
+     * For contiguous or segmented character sources, whitespace runs are skipped 16 bytes at a time (SSE2),
+     * and the end of block comments is searched with a memchr-based scan.
+     */
+    class Skipper {
+    public:
+        /**
+         * Constructor.
+         * @param whitespace whitespace characters.
+         * @param lineCommentStart start of line comment; if empty, line comments are not recognized.
+         * @param blockCommentStart start of block comment; if empty, block comments are not recognized.
+         * @param blockCommentEnd end of block comment.
+         */
+        Skipper(const std::string& whitespace = " \t\r\n", const std::string& lineCommentStart = "", const std::string& blockCommentStart = "", const std::string& blockCommentEnd = "")
+            : m_whitespace(whitespace)
+            , m_lineCommentStart(lineCommentStart)
+            , m_blockCommentStart(blockCommentStart)
+            , m_blockCommentEnd(blockCommentEnd)
+        {
+            std::fill(std::begin(m_whitespaceTable), std::end(m_whitespaceTable), false);
+            for (const char c : m_whitespace) {
+                m_whitespaceTable[static_cast<unsigned char>(c)] = true;
+            }
+        }
+
+        /**
+         * Returns the whitespace characters.
+         * @return the whitespace characters.
+         */
+        const std::string& whitespace() const {
+            return m_whitespace;
+        }
+
+        /**
+         * Returns the start of line comments.
+         * @return the start of line comments.
+         */
+        const std::string& lineCommentStart() const {
+            return m_lineCommentStart;
+        }
+
+        /**
+         * Returns the start of block comments.
+         * @return the start of block comments.
+         */
+        const std::string& blockCommentStart() const {
+            return m_blockCommentStart;
+        }
+
+        /**
+         * Returns the end of block comments.
+         * @return the end of block comments.
+         */
+        const std::string& blockCommentEnd() const {
+            return m_blockCommentEnd;
+        }
+
+        /**
+         * Skips whitespace and comments.
+         * @param it the position to start skipping from.
+         * @param end end of source.
+         * @return the position after the skipped whitespace and comments.
+         */
+        template <class Iterator> Iterator skip(Iterator it, const Iterator& end) const {
+            for (;;) {
+                it = skipWhitespace(it, end);
+
+                //line comment
+                if (startsWith(it, end, m_lineCommentStart)) {
+                    it = std::find(it, end, '\n');
+                    continue;
+                }
+
+                //block comment
+                if (startsWith(it, end, m_blockCommentStart)) {
+                    const Iterator commentEnd = find(std::next(it, m_blockCommentStart.size()), end, m_blockCommentEnd);
+                    if (commentEnd == end) {
+                        break;
+                    }
+                    it = std::next(commentEnd, m_blockCommentEnd.size());
+                    continue;
+                }
+
+                break;
+            }
+            return it;
+        }
+
+    private:
+        std::string m_whitespace;
+        std::string m_lineCommentStart;
+        std::string m_blockCommentStart;
+        std::string m_blockCommentEnd;
+        bool m_whitespaceTable[256];
+
+        template <class T> bool isWhitespace(const T& value) const {
+            if constexpr (sizeof(T) == 1) {
+                return m_whitespaceTable[static_cast<unsigned char>(value)];
+            }
+            else {
+                return value >= 0 && value < 256 && m_whitespaceTable[static_cast<unsigned char>(value)];
+            }
+        }
+
+        template <class Iterator> Iterator skipWhitespace(Iterator it, const Iterator& end) const {
+            if constexpr (hasContiguousSegments<Iterator>() && sizeof(typename std::iterator_traits<Iterator>::value_type) == 1) {
+                return scanSegments(it, end, [&](const auto* begin, const auto* segmentEnd) {
+                    return skipWhitespaceInBlock(begin, segmentEnd);
+                });
+            }
+            else {
+                for (; it != end && isWhitespace(*it); ++it) {
+                }
+                return it;
+            }
+        }
+
+        template <class T> const T* skipWhitespaceInBlock(const T* it, const T* end) const {
+            #ifdef PARSERLIB_SSE2
+            while (end - it >= 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                __m128i mask = _mm_setzero_si128();
+                for (const char c : m_whitespace) {
+                    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)));
+                }
+                const unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(mask));
+                if (bits != 0xFFFF) {
+                    return it + countTrailingZeros(~bits);
+                }
+                it += 16;
+            }
+            #endif
+
+            for (; it != end && isWhitespace(*it); ++it) {
+            }
+            return it;
+        }
+
+        template <class Iterator> static bool startsWith(const Iterator& it, const Iterator& end, const std::string& str) {
+            if (str.empty()) {
+                return false;
+            }
+            auto sit = it;
+            for (const char c : str) {
+                if (sit == end || *sit != c) {
+                    return false;
+                }
+                ++sit;
+            }
+            return true;
+        }
+
+        template <class Iterator> static Iterator find(const Iterator& it, const Iterator& end, const std::string& str) {
+            if constexpr (isContiguousIterator<Iterator>() && std::is_same_v<typename std::iterator_traits<Iterator>::value_type, char>) {
+                if (it == end) {
+                    return end;
+                }
+                const std::string_view view(toPointer(it), static_cast<size_t>(end - it));
+                const size_t pos = view.find(str);
+                return pos == std::string_view::npos ? end : it + pos;
+            }
+            else {
+                return std::search(it, end, str.begin(), str.end());
+            }
+        }
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SKIPPER_HPP
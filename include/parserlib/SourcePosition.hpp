@@ -5,6 +5,7 @@
 #include <cctype>
 #include <vector>
 #include <string>
+#include "util.hpp"
 
 
 namespace parserlib {
@@ -17,6 +18,11 @@ namespace parserlib {
      */
     template <class SourceType = std::string, bool CaseSensitive = true> class SourcePosition {
     public:
+        /**
+         * True if elements are compared case sensitively, false otherwise.
+         */
+        static constexpr bool caseSensitive = CaseSensitive;
+
         /**
          * The default constructor.
          */
@@ -28,7 +34,7 @@ namespace parserlib {
          * @param begin iterator to the first element of the source.
          * @param end iterator to the end of the source.
          */
-        SourcePosition(const typename SourceType::const_iterator& begin, const typename SourceType::const_iterator& end)
+        SourcePosition(const SourceIterator<SourceType>& begin, const SourceIterator<SourceType>& end)
             : m_iterator(begin)
             , m_end(end)
         {
@@ -38,7 +44,7 @@ namespace parserlib {
          * Returns the iterator.
          * @return the iterator.
          */
-        const typename SourceType::const_iterator& iterator() const {
+        const SourceIterator<SourceType>& iterator() const {
             return m_iterator;
         }
 
@@ -46,7 +52,7 @@ namespace parserlib {
          * Returns the end of the source.
          * @return the end of the source.
          */
-        const typename SourceType::const_iterator& end() const {
+        const SourceIterator<SourceType>& end() const {
             return m_end;
         }
 
@@ -58,7 +64,7 @@ namespace parserlib {
          * @return true if equal, false otherwise.
          */
         template <class T>
-        static bool contains(const typename SourceType::const_iterator& iterator, const T& value) {
+        static bool contains(const SourceIterator<SourceType>& iterator, const T& value) {
             if constexpr (CaseSensitive) {
                 return *iterator == value;
             }
@@ -76,7 +82,7 @@ namespace parserlib {
          * @return true if within range, false otherwise.
          */
         template <class T>
-        static bool contains(const typename SourceType::const_iterator& iterator, const T& minValue, const T& maxValue) {
+        static bool contains(const SourceIterator<SourceType>& iterator, const T& minValue, const T& maxValue) {
             if constexpr (CaseSensitive) {
                 return *iterator >= minValue && *iterator <= maxValue;
             }
@@ -93,7 +99,7 @@ namespace parserlib {
          * @return true if within container, false otherwise.
          */
         template <class T, class Alloc>
-        static bool contains(const typename SourceType::const_iterator& iterator, const std::vector<T, Alloc>& values) {
+        static bool contains(const SourceIterator<SourceType>& iterator, const std::vector<T, Alloc>& values) {
             for (const T& value : values) {
                 if (contains(iterator, value)) {
                     return true;
@@ -106,11 +112,27 @@ namespace parserlib {
          * Compares the current value with the given null-terminated string.
          * If CaseSensitive is false, then values are set to lowercase before compared.
          * @param iterator position in source that contains the element to compare to the value.
+         * @param end end of the source.
          * @param str null-terminated string.
          * @return true if string is present at the given position, false otherwise.
          */
         template <class T>
-        static bool contains(const typename SourceType::const_iterator& iterator, const typename SourceType::const_iterator& end, const T* str) {
+        static bool contains(const SourceIterator<SourceType>& iterator, const SourceIterator<SourceType>& end, const T* str) {
+            return containsString(iterator, end, str);
+        }
+
+        /**
+         * Compares the current value with the given null-terminated string.
+         * Same as 'contains(iterator, end, str)'; it is not ambiguous with 'contains(iterator, minValue, maxValue)'
+         * when source iterators are pointers.
+         * If CaseSensitive is false, then values are set to lowercase before compared.
+         * @param iterator position in source that contains the element to compare to the value.
+         * @param end end of the source.
+         * @param str null-terminated string.
+         * @return true if string is present at the given position, false otherwise.
+         */
+        template <class T>
+        static bool containsString(const SourceIterator<SourceType>& iterator, const SourceIterator<SourceType>& end, const T* str) {
             auto it = iterator;
             const T* ts = str;
 
@@ -181,7 +203,7 @@ namespace parserlib {
          */
         template <class T>
         bool contains(const T* str) const {
-            return contains(m_iterator, m_end, str);
+            return containsString(m_iterator, m_end, str);
         }
 
         /**
@@ -191,6 +213,17 @@ namespace parserlib {
             ++m_iterator;
         }
 
+        /**
+         * Moves the position to an equivalent place of another source, keeping any other state (e.g. line and column);
+         * used for forking parse contexts over other sources in O(1).
+         * @param it iterator of the other source that corresponds to the current position.
+         * @param end end of the other source.
+         */
+        void rebase(const SourceIterator<SourceType>& it, const SourceIterator<SourceType>& end) {
+            m_iterator = it;
+            m_end = end;
+        }
+
         /**
          * Increases the position by multiple places.
          * @param count number of places to increase the position by.
@@ -213,7 +246,7 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if they are equal, false otherwise.
          */
-        bool operator == (const typename SourceType::const_iterator& it) const {
+        bool operator == (const SourceIterator<SourceType>& it) const {
             return m_iterator == it;
         }
 
@@ -231,7 +264,7 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if they are different, false otherwise.
          */
-        bool operator != (const typename SourceType::const_iterator& it) const {
+        bool operator != (const SourceIterator<SourceType>& it) const {
             return m_iterator != it;
         }
 
@@ -249,7 +282,7 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if the comparison is true, false otherwise.
          */
-        bool operator < (const typename SourceType::const_iterator& it) const {
+        bool operator < (const SourceIterator<SourceType>& it) const {
             return m_iterator < it;
         }
 
@@ -267,7 +300,7 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if the comparison is true, false otherwise.
          */
-        bool operator > (const typename SourceType::const_iterator& it) const {
+        bool operator > (const SourceIterator<SourceType>& it) const {
             return m_iterator > it;
         }
 
@@ -285,7 +318,7 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if the comparison is true, false otherwise.
          */
-        bool operator <= (const typename SourceType::const_iterator& it) const {
+        bool operator <= (const SourceIterator<SourceType>& it) const {
             return m_iterator <= it;
         }
 
@@ -303,13 +336,13 @@ namespace parserlib {
          * @param it iterator to compare to this.
          * @return true if the comparison is true, false otherwise.
          */
-        bool operator >= (const typename SourceType::const_iterator& it) const {
+        bool operator >= (const SourceIterator<SourceType>& it) const {
             return m_iterator >= it;
         }
 
     private:
-        typename SourceType::const_iterator m_iterator;
-        typename SourceType::const_iterator m_end;
+        SourceIterator<SourceType> m_iterator;
+        SourceIterator<SourceType> m_end;
     };
 
 
@@ -0,0 +1,121 @@
+#ifndef PARSERLIB_SYMBOLPARSER_HPP
+#define PARSERLIB_SYMBOLPARSER_HPP
+
+
+#include <iterator>
+#include "ValueMatchParser.hpp"
+#include "SymbolTable.hpp"
+#include "FirstSet.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A parser that interns the input parsed by its child into a symbol table, while parsing.
+     *
+     * As a value parser, it can be given a match id, e.g. 'symbol(identifier, table) == "identifier"';
+     * the value of the match is the id of the symbol ('unsigned long long'), i.e. the symbol is available
+     * with no extra pass over the matches, and no allocation per occurrence of a symbol already in the table.
+     * The interned input is the content of the match; with a skipper, the child should be a lexeme,
+     * so as that trailing whitespace is not part of the symbol.
+     * @param ParserNodeType type of child.
+     * @param CharType character type of the symbol table.
+     */
+    template <class ParserNodeType, class CharType> class SymbolParser : public ValueParserNode<SymbolParser<ParserNodeType, CharType>> {
+    public:
+        /**
+         * Constructor.
+         * @param child the parser that parses the symbol.
+         * @param table the table to intern symbols to; it must outlive the parser.
+         */
+        SymbolParser(const ParserNodeType& child, SymbolTable<CharType>& table) : m_child(child), m_table(&table) {
+        }
+
+        /**
+         * Returns the child.
+         * @return the child.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Returns the symbol table.
+         * @return the symbol table.
+         */
+        SymbolTable<CharType>& table() const {
+            return *m_table;
+        }
+
+        /**
+         * Invokes the child; if it succeeds, the parsed input is interned.
+         * @param pc parse context.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            MatchValue value;
+            return parseValue(pc, value);
+        }
+
+        /**
+         * Invokes the child; if it succeeds, the parsed input is interned.
+         * @param pc parse context.
+         * @param value the result value; the id of the symbol, as 'unsigned long long'.
+         * @return true if parsing succeeds, false otherwise.
+         */
+        template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const {
+            return pc.parseAfterSkip([&]() {
+                const auto begin = pc.sourcePosition().iterator();
+                if (!m_child(pc)) {
+                    return false;
+                }
+                value = static_cast<unsigned long long>(m_table->intern(begin, pc.sourcePosition().iterator()));
+                return true;
+                });
+        }
+
+        /**
+         * Does nothing; symbols are terminals, and a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        const ParserNodeType m_child;
+        SymbolTable<CharType>* const m_table;
+    };
+
+
+    /**
+     * Creates a parser that interns the input parsed by the given parser into a symbol table.
+     * @param parser the parser that parses the symbol.
+     * @param table the table to intern symbols to; it must outlive the parser.
+     * @return a symbol parser.
+     */
+    template <class ParserNodeType, class CharType>
+    SymbolParser<ParserNodeType, CharType> symbol(const ParserNode<ParserNodeType>& parser, SymbolTable<CharType>& table) {
+        return SymbolParser<ParserNodeType, CharType>(static_cast<const ParserNodeType&>(parser), table);
+    }
+
+
+    /**
+     * Computes the first set of a symbol parser.
+     * @param parser the parser.
+     * @param context the context.
+     * @return the first set of the child.
+     */
+    template <class ParserNodeType, class CharType> FirstSet computeFirstSet(const SymbolParser<ParserNodeType, CharType>& parser, FirstSetContext& context) {
+        return computeFirstSet(parser.child(), context);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SYMBOLPARSER_HPP
@@ -0,0 +1,114 @@
+#ifndef PARSERLIB_SYMBOLTABLE_HPP
+#define PARSERLIB_SYMBOLTABLE_HPP
+
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "util.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * A table of distinct strings (symbols), each one identified by a number.
+     *
+     * The table owns one copy of each distinct string; interning a string that is already in the table
+     * allocates no memory. Symbol ids are consecutive, starting from 0, in the order the symbols are added.
+     *
+     * The table can be shared between threads: lookups take a shared lock, and only the insertion of a new symbol
+     * takes an exclusive lock.
+     * @param CharType character type.
+     */
+    template <class CharType = char> class SymbolTable {
+    public:
+        /**
+         * String type.
+         */
+        using StringType = std::basic_string<CharType>;
+
+        /**
+         * String view type.
+         */
+        using StringViewType = std::basic_string_view<CharType>;
+
+        /**
+         * Returns the id of a string; if the string is not in the table, it is added to it.
+         * @param str the string.
+         * @return the id of the string.
+         */
+        size_t intern(const StringViewType& str) {
+            {
+                std::shared_lock lock(m_mutex);
+                const auto it = m_ids.find(str);
+                if (it != m_ids.end()) {
+                    return it->second;
+                }
+            }
+
+            std::unique_lock lock(m_mutex);
+
+            //another thread may have added the string in the meantime
+            const auto it = m_ids.find(str);
+            if (it != m_ids.end()) {
+                return it->second;
+            }
+
+            //the strings of a deque are not moved when another string is added, so the views to them remain valid
+            const size_t id = m_symbols.size();
+            m_symbols.emplace_back(str);
+            m_ids.emplace(StringViewType(m_symbols.back()), id);
+            return id;
+        }
+
+        /**
+         * Returns the id of the string of a source range; if the string is not in the table, it is added to it.
+         * Ranges of contiguous sources are looked up in place; other ranges are copied to a temporary string first.
+         * @param begin start of range.
+         * @param end end of range.
+         * @return the id of the string.
+         */
+        template <class Iterator> size_t intern(const Iterator& begin, const Iterator& end) {
+            if constexpr (isContiguousIterator<Iterator>()) {
+                return intern(begin == end ? StringViewType() : StringViewType(toPointer(begin), static_cast<size_t>(end - begin)));
+            }
+            else {
+                return intern(StringViewType(StringType(begin, end)));
+            }
+        }
+
+        /**
+         * Returns the string of a symbol.
+         * @param id id of the symbol; it must have been returned by 'intern'.
+         * @return the string of the symbol; it remains valid as long as the table exists.
+         */
+        StringViewType symbol(size_t id) const {
+            std::shared_lock lock(m_mutex);
+            return m_symbols[id];
+        }
+
+        /**
+         * Returns the number of symbols.
+         * @return the number of symbols.
+         */
+        size_t size() const {
+            std::shared_lock lock(m_mutex);
+            return m_symbols.size();
+        }
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::deque<StringType> m_symbols;
+        std::unordered_map<StringViewType, size_t> m_ids;
+    };
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_SYMBOLTABLE_HPP
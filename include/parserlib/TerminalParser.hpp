@@ -40,19 +40,28 @@ namespace parserlib {
          * @return true if parsing succeeds, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            if (!pc.sourceEnded()) {
-                if (pc.sourcePositionContains(m_terminalValue)) {
+            return pc.parseAfterSkip([&]() {
+                if (sourcePositionContainsValue(pc)) {
                     pc.incrementSourcePosition();
                     return true;
                 }
-                else {
+                if (!pc.sourceEnded()) {
                     pc.addError(pc.sourcePosition(), [&]() {
                         return makeError(ErrorType::SyntaxError, pc.sourcePosition(),
                             toString("Syntax error: expected: ", m_terminalValue, ", found: ", *pc.sourcePosition().iterator())); 
                         });
                 }
-            }
-            return false;
+                return false;
+                });
+        }
+
+        /**
+         * Checks if the terminal is at the current position, without consuming it and without adding an error.
+         * @param pc parse context.
+         * @return true if the terminal is at the current position, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            return pc.peek([&]() { return sourcePositionContainsValue(pc); });
         }
 
         /**
@@ -67,6 +76,10 @@ namespace parserlib {
         }
 
     private:
+        template <class ParseContextType> bool sourcePositionContainsValue(const ParseContextType& pc) const {
+            return (!needsEndCheck<typename ParseContextType::SourceType>(m_terminalValue == TerminalValueType()) || !pc.sourceEnded()) && pc.sourcePositionContains(m_terminalValue);
+        }
+
         //the terminal value.
         const TerminalValueType m_terminalValue;
     };
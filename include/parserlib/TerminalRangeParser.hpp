@@ -49,19 +49,28 @@ namespace parserlib {
          * @return true if parsing succeeds, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            if (!pc.sourceEnded()) {
-                if (pc.sourcePositionContains(m_minTerminalValue, m_maxTerminalValue)) {
+            return pc.parseAfterSkip([&]() {
+                if (sourcePositionContainsValue(pc)) {
                     pc.incrementSourcePosition();
                     return true;
                 }
-                else {
+                if (!pc.sourceEnded()) {
                     pc.addError(pc.sourcePosition(), [&]() {
                         return makeError(ErrorType::SyntaxError, pc.sourcePosition(),
                             toString("Syntax error: expected one of: ", tokenToString(m_minTerminalValue), "..", tokenToString(m_maxTerminalValue), ", found: ", *pc.sourcePosition().iterator()));
                         });
                 }
-            }
-            return false;
+                return false;
+                });
+        }
+
+        /**
+         * Checks if the terminal is at the current position, without consuming it and without adding an error.
+         * @param pc parse context.
+         * @return true if the terminal is at the current position, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            return pc.peek([&]() { return sourcePositionContainsValue(pc); });
         }
 
         /**
@@ -76,6 +85,11 @@ namespace parserlib {
         }
 
     private:
+        template <class ParseContextType> bool sourcePositionContainsValue(const ParseContextType& pc) const {
+            const bool containsZero = !(TerminalValueType() < m_minTerminalValue) && !(m_maxTerminalValue < TerminalValueType());
+            return (!needsEndCheck<typename ParseContextType::SourceType>(containsZero) || !pc.sourceEnded()) && pc.sourcePositionContains(m_minTerminalValue, m_maxTerminalValue);
+        }
+
         const TerminalValueType m_minTerminalValue;
         const TerminalValueType m_maxTerminalValue;
     };
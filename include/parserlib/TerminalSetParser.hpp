@@ -3,6 +3,7 @@
 
 
 #include <vector>
+#include <algorithm>
 #include "ParserNode.hpp"
 #include "util.hpp"
 #include "Error.hpp"
@@ -24,6 +25,7 @@ namespace parserlib {
          */
         TerminalSetParser(const std::vector<TerminalValueType>& terminalValues)
             : m_terminalValues(terminalValues)
+            , m_containsZero(std::find(terminalValues.begin(), terminalValues.end(), TerminalValueType()) != terminalValues.end())
         {
         }
 
@@ -41,19 +43,28 @@ namespace parserlib {
          * @return true if parsing succeeds, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            if (!pc.sourceEnded()) {
-                if (pc.sourcePositionContains(m_terminalValues)) {
+            return pc.parseAfterSkip([&]() {
+                if (sourcePositionContainsValue(pc)) {
                     pc.incrementSourcePosition();
                     return true;
                 }
-                else {
+                if (!pc.sourceEnded()) {
                     pc.addError(pc.sourcePosition(), [&]() {
                         return makeError(ErrorType::SyntaxError, pc.sourcePosition(),
                             toString("Syntax error: expected one of: ", m_terminalValues, ", found: ", *pc.sourcePosition().iterator()));
                         });
                 }
-            }
-            return false;
+                return false;
+                });
+        }
+
+        /**
+         * Checks if the terminal is at the current position, without consuming it and without adding an error.
+         * @param pc parse context.
+         * @return true if the terminal is at the current position, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            return pc.peek([&]() { return sourcePositionContainsValue(pc); });
         }
 
         /**
@@ -69,6 +80,11 @@ namespace parserlib {
 
     private:
         std::vector<TerminalValueType> m_terminalValues;
+        bool m_containsZero;
+
+        template <class ParseContextType> bool sourcePositionContainsValue(const ParseContextType& pc) const {
+            return (!needsEndCheck<typename ParseContextType::SourceType>(m_containsZero) || !pc.sourceEnded()) && pc.sourcePositionContains(m_terminalValues);
+        }
     };
 
 
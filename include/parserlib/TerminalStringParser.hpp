@@ -2,7 +2,11 @@
 #define PARSERLIB_TERMINALSTRINGPARSER_HPP
 
 
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <vector>
 #include "ParserNode.hpp"
 #include "util.hpp"
 #include "Error.hpp"
@@ -23,6 +27,16 @@ namespace parserlib {
          * @param string string.
          */
         TerminalStringParser(const TerminalValueType* string) : m_string(string) {
+            if constexpr (sizeof(TerminalValueType) == 1) {
+                if (!m_string.empty()) {
+                    const size_t wordCount = (m_string.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+                    m_words.resize(wordCount, 0);
+                    std::memcpy(m_words.data(), m_string.data(), m_string.size());
+                    unsigned char lastMask[sizeof(std::uint64_t)] = {};
+                    std::memset(lastMask, 0xFF, m_string.size() - (wordCount - 1) * sizeof(std::uint64_t));
+                    std::memcpy(&m_lastMask, lastMask, sizeof(m_lastMask));
+                }
+            }
         }
 
         /**
@@ -30,7 +44,7 @@ namespace parserlib {
          * @return the string.
          */
         const TerminalValueType* string() const {
-            return m_string;
+            return m_string.c_str();
         }
         
         /**
@@ -39,19 +53,28 @@ namespace parserlib {
          * @return true if parsing succeeds, false otherwise.
          */
         template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
-            if (!pc.sourceEnded()) {
-                if (pc.sourcePositionContains(m_string.c_str())) {
+            return pc.parseAfterSkip([&]() {
+                if (sourcePositionContainsString(pc)) {
                     pc.increaseSourcePosition(m_string.size());
                     return true;
                 }
-                else {
+                if (!pc.sourceEnded()) {
                     pc.addError(pc.sourcePosition(), [&]() {
                         return makeError(ErrorType::SyntaxError, pc.sourcePosition(),
                             toString("Syntax error: expected: \"", m_string, "\", found: \"", toSubString(pc.sourcePosition().iterator(), pc.sourcePosition().end(), m_string.length()), "\""));
                         });
                 }
-            }
-            return false;
+                return false;
+                });
+        }
+
+        /**
+         * Checks if the terminal is at the current position, without consuming it and without adding an error.
+         * @param pc parse context.
+         * @return true if the terminal is at the current position, false otherwise.
+         */
+        template <class ParseContextType> bool peek(ParseContextType& pc) const {
+            return pc.peek([&]() { return sourcePositionContainsString(pc); });
         }
 
         /**
@@ -66,7 +89,41 @@ namespace parserlib {
         }
 
     private:
-        const std::basic_string<TerminalValueType> m_string;
+        std::basic_string<TerminalValueType> m_string;
+
+        //the string as 64-bit words, for comparing against zero-padded sources; the last word is masked
+        std::vector<std::uint64_t> m_words;
+        std::uint64_t m_lastMask{ 0 };
+
+        //in a zero-padded source, the string is compared 8 bytes at a time without checking for the end of the source:
+        //all bytes of the string are non-zero, so the comparison fails at the first sentinel,
+        //and every word is read from a position up to the end of the source, i.e. within the padding
+        template <class ParseContextType> bool sourcePositionContainsString(const ParseContextType& pc) const {
+            using SourceType = typename ParseContextType::SourceType;
+            using Iterator = SourceIterator<SourceType>;
+            if constexpr (SourcePadding<SourceType>::value >= sizeof(std::uint64_t) && isContiguousIterator<Iterator>() &&
+                sizeof(typename std::iterator_traits<Iterator>::value_type) == 1 && sizeof(TerminalValueType) == 1 &&
+                IsCaseSensitivePosition<typename ParseContextType::PositionType>::value)
+            {
+                if (!m_words.empty()) {
+                    return wordsEqual(reinterpret_cast<const unsigned char*>(toPointer(pc.sourcePosition().iterator())));
+                }
+            }
+            return !pc.sourceEnded() && pc.sourcePositionContains(m_string.c_str());
+        }
+
+        bool wordsEqual(const unsigned char* bytes) const {
+            const size_t last = m_words.size() - 1;
+            std::uint64_t word;
+            for (size_t index = 0; index < last; ++index, bytes += sizeof(word)) {
+                std::memcpy(&word, bytes, sizeof(word));
+                if (word != m_words[index]) {
+                    return false;
+                }
+            }
+            std::memcpy(&word, bytes, sizeof(word));
+            return ((word ^ m_words[last]) & m_lastMask) == 0;
+        }
     };
 
 
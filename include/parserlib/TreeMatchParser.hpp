@@ -79,15 +79,17 @@ namespace parserlib {
         const MatchIdType m_matchId;
 
         template <class ParseContextType, class PF> bool parse(ParseContextType& pc, const PF& pf) const {
-            const auto begin = pc.sourcePosition();
-            const size_t beginMatchCount = pc.matches().size();
-            if (pf()) {
-                const size_t endMatchCount = pc.matches().size();
-                const size_t childMatchCount = endMatchCount - beginMatchCount;
-                pc.addMatch(m_matchId, begin, pc.sourcePosition(), childMatchCount);
-                return true;
-            }
-            return false;
+            return pc.parseAfterSkip([&]() {
+                const auto begin = pc.sourcePosition();
+                const size_t beginMatchCount = pc.matches().size();
+                if (pf()) {
+                    const size_t endMatchCount = pc.matches().size();
+                    const size_t childMatchCount = endMatchCount - beginMatchCount;
+                    pc.addMatch(m_matchId, begin, pc.sourcePosition(), childMatchCount);
+                    return true;
+                }
+                return false;
+                });
         }
     };
 
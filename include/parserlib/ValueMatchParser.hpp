@@ -0,0 +1,126 @@
+#ifndef PARSERLIB_VALUEMATCHPARSER_HPP
+#define PARSERLIB_VALUEMATCHPARSER_HPP
+
+
+#include <string>
+#include "ParserNode.hpp"
+#include "Match.hpp"
+
+
+namespace parserlib {
+
+
+    /**
+     * Base class for parser nodes that compute a value while parsing.
+     * Derived classes must provide the function:
+     *
+     *  template <class ParseContextType> bool parseValue(ParseContextType& pc, MatchValue& value) const;
+     *
+     * which parses the input and sets the value on success.
+     * @param ParserNodeType type of parser node derived from this.
+     */
+    template <class ParserNodeType> class ValueParserNode : public ParserNode<ParserNodeType> {
+    public:
+    };
+
+
+    /**
+     * A parser that adds a match with a value to the current parse context,
+     * if a value parser parses the input succecssfully.
+     * @param ParserNodeType the value parser to invoke.
+     * @param MatchIdType type of match id.
+     */
+    template <class ParserNodeType, class MatchIdType> class ValueMatchParser
+        : public ParserNode<ValueMatchParser<ParserNodeType, MatchIdType>> {
+    public:
+        /**
+         * The default constructor.
+         * @param child child parser to invoke.
+         * @param matchId the match id.
+         */
+        ValueMatchParser(const ParserNodeType& child, const MatchIdType& matchId)
+            : m_child(child), m_matchId(matchId) {
+        }
+
+        /**
+         * Returns the parser to invoke.
+         * @return the parser to invoke.
+         */
+        const ParserNodeType& child() const {
+            return m_child;
+        }
+
+        /**
+         * Returns the match id.
+         * @return the match id.
+         */
+        const MatchIdType& matchId() const {
+            return m_matchId;
+        }
+
+        /**
+         * If the child parser succeeds, then a match with the parsed value is added to the context.
+         * @param pc parse context.
+         * @return true if parsing succeeded, false otherwise.
+         */
+        template <class ParseContextType> bool operator ()(ParseContextType& pc) const {
+            return pc.parseAfterSkip([&]() {
+                const auto begin = pc.sourcePosition();
+                MatchValue value;
+                if (m_child.parseValue(pc, value)) {
+                    pc.addMatch(m_matchId, begin, pc.sourcePosition(), value);
+                    return true;
+                }
+                return false;
+                });
+        }
+
+        /**
+         * Does nothing; value parsers are terminals, and a terminal should not parse when a rule is expected to parse,
+         * in order to continue after the non-left recursive part is parsed.
+         * @param pc parse context.
+         * @param lrc left recursion context.
+         * @return always false.
+         */
+        template <class ParseContextType> bool parseLeftRecursionContinuation(ParseContextType& /*pc*/, LeftRecursionContext<ParseContextType>& /*lrc*/) const {
+            return false;
+        }
+
+    private:
+        const ParserNodeType m_child;
+        const MatchIdType m_matchId;
+    };
+
+
+    /**
+     * Operator that allows a value parser match to be inserted into the grammar.
+     * The created match contains the value computed by the parser.
+     * @param node node to apply the operator to.
+     * @param matchId match id.
+     * @return a value match parser.
+     */
+    template <class ParserNodeType, class MatchIdType>
+    ValueMatchParser<ParserNodeType, MatchIdType>
+        operator == (const ValueParserNode<ParserNodeType>& node, const MatchIdType& matchId) {
+        return ValueMatchParser<ParserNodeType, MatchIdType>(static_cast<const ParserNodeType&>(node), matchId);
+    }
+
+
+    /**
+     * Operator that allows a value parser match with a character string match id to be inserted into the grammar.
+     * The created match contains the value computed by the parser.
+     * @param node node to apply the operator to.
+     * @param matchId match id.
+     * @return a value match parser.
+     */
+    template <class ParserNodeType, class CharType>
+    ValueMatchParser<ParserNodeType, std::basic_string<CharType>>
+        operator == (const ValueParserNode<ParserNodeType>& node, const CharType* matchId) {
+        return ValueMatchParser<ParserNodeType, std::basic_string<CharType>>(static_cast<const ParserNodeType&>(node), matchId);
+    }
+
+
+} //namespace parserlib
+
+
+#endif //PARSERLIB_VALUEMATCHPARSER_HPP
@@ -7,6 +7,31 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define PARSERLIB_LITTLE_ENDIAN
+#endif
+
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>
+#define PARSERLIB_CPP20
+#endif
+
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARSERLIB_SSE2
+#endif
+
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 
 namespace parserlib {
@@ -89,8 +114,232 @@ namespace parserlib {
     }
 
 
-    inline std::string toSubString(const std::string::const_iterator& begin, const std::string::const_iterator& end, size_t len) {
-        return std::string(begin, begin + std::min(static_cast<std::ptrdiff_t>(len), std::distance(begin, end)));
+    /**
+     * Type of iterator used for reading a source; it is the type returned by 'begin()' of a const source.
+     * @param SourceType source type.
+     */
+    template <class SourceType> using SourceIterator = decltype(std::declval<const SourceType&>().begin());
+
+
+    /**
+     * Trait that checks if a type is a string view.
+     * @param T type to check.
+     */
+    template <class T> struct IsStringView : std::false_type {
+    };
+
+
+    template <class CharT, class Traits> struct IsStringView<std::basic_string_view<CharT, Traits>> : std::true_type {
+    };
+
+
+    /**
+     * Checks if the given iterator type points to contiguous memory,
+     * allowing the elements to be accessed via a pointer.
+     * @param Iterator iterator type.
+     * @return true if the iterator is a pointer or an iterator of std::vector, std::basic_string, std::basic_string_view or std::span, false otherwise.
+     */
+    template <class Iterator> constexpr bool isContiguousIterator() {
+        using T = typename std::iterator_traits<Iterator>::value_type;
+        if constexpr (std::is_pointer_v<Iterator>) {
+            return true;
+        }
+        #ifdef PARSERLIB_CPP20
+        else if constexpr (std::contiguous_iterator<Iterator>) {
+            return true;
+        }
+        #endif
+        else if constexpr (std::is_same_v<T, bool>) {
+            return false;
+        }
+        else if constexpr (std::is_same_v<Iterator, typename std::vector<T>::const_iterator> || std::is_same_v<Iterator, typename std::vector<T>::iterator>) {
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>) {
+            return std::is_same_v<Iterator, typename std::basic_string<T>::const_iterator> || std::is_same_v<Iterator, typename std::basic_string<T>::iterator> ||
+                std::is_same_v<Iterator, typename std::basic_string_view<T>::const_iterator>;
+        }
+        else {
+            return false;
+        }
+    }
+
+
+    /**
+     * Trait that checks if a source position type compares elements case sensitively.
+     * Source position types that do not declare the constant 'caseSensitive' are assumed to be case sensitive.
+     * @param PositionType source position type.
+     */
+    template <class PositionType, class = void> struct IsCaseSensitivePosition : std::true_type {
+    };
+
+
+    template <class PositionType> struct IsCaseSensitivePosition<PositionType, std::void_t<decltype(PositionType::caseSensitive)>>
+        : std::bool_constant<PositionType::caseSensitive> {
+    };
+
+
+    /**
+     * Trait that returns the number of zero elements that a source guarantees to be readable past its end;
+     * sources declare it with the constant 'padding' (see PaddedSource); for other sources, it is 0.
+     * @param SourceType source type.
+     */
+    template <class SourceType, class = void> struct SourcePadding : std::integral_constant<size_t, 0> {
+    };
+
+
+    template <class SourceType> struct SourcePadding<SourceType, std::void_t<decltype(SourceType::padding)>>
+        : std::integral_constant<size_t, SourceType::padding> {
+    };
+
+
+    /**
+     * Trait that returns the type of the content of matches over a source.
+     * It is the source type, except for padded sources: the elements after a match are not zero,
+     * and therefore the content of a match over a padded source is a string view, which is always end-checked.
+     * @param SourceType source type.
+     */
+    template <class SourceType> struct SourceContent {
+        using type = std::conditional_t<(SourcePadding<SourceType>::value > 0), std::basic_string_view<typename SourceType::value_type>, SourceType>;
+    };
+
+
+    /**
+     * Checks if a terminal parser must check for the end of the source before comparing the current element.
+     * In zero-padded sources, a comparison that does not match zero cannot succeed past the end,
+     * and therefore the end needs to be checked only when the comparison fails.
+     * @param SourceType source type.
+     * @param matchesZero true if the comparison succeeds for a zero element.
+     * @return true if the end of the source must be checked first, false otherwise.
+     */
+    template <class SourceType> constexpr bool needsEndCheck(bool matchesZero) {
+        return SourcePadding<SourceType>::value == 0 || matchesZero;
+    }
+
+
+    /**
+     * Returns a pointer to the element of a contiguous iterator.
+     * @param it iterator; it must be dereferenceable.
+     * @return pointer to the element.
+     */
+    template <class Iterator> auto toPointer(const Iterator& it) {
+        return &*it;
+    }
+
+
+    /**
+     * Trait that checks if an iterator is segmented, i.e. if its elements are stored in contiguous segments;
+     * segmented iterators provide the functions 'segmentData()', which returns a pointer to the current element,
+     * and 'segmentSize()', which returns the number of elements from the current one to the end of the current segment.
+     * @param Iterator iterator type.
+     */
+    template <class Iterator, class = void> struct IsSegmentedIterator : std::false_type {
+    };
+
+
+    template <class Iterator> struct IsSegmentedIterator<Iterator, std::void_t<decltype(std::declval<const Iterator&>().segmentSize())>> : std::true_type {
+    };
+
+
+    /**
+     * Checks if the elements of an iterator range can be accessed via pointers, one contiguous segment at a time.
+     * @param Iterator iterator type.
+     * @return true if the iterator is contiguous or segmented, false otherwise.
+     */
+    template <class Iterator> constexpr bool hasContiguousSegments() {
+        return isContiguousIterator<Iterator>() || IsSegmentedIterator<Iterator>::value;
+    }
+
+
+    /**
+     * Returns the number of elements that can be accessed via a pointer from the given position,
+     * i.e. up to the end of the range, or of the current segment.
+     * @param it position; the iterator must be contiguous or segmented.
+     * @param end end of range.
+     * @return number of elements that can be accessed via a pointer.
+     */
+    template <class Iterator> size_t contiguousSize(const Iterator& it, const Iterator& end) {
+        const auto remaining = static_cast<size_t>(end - it);
+        if constexpr (isContiguousIterator<Iterator>()) {
+            return remaining;
+        }
+        else {
+            return it == end ? 0 : std::min(static_cast<size_t>(it.segmentSize()), remaining);
+        }
+    }
+
+
+    /**
+     * Scans a range of a contiguous or segmented iterator, one contiguous segment at a time.
+     * @param it start of range.
+     * @param end end of range.
+     * @param scan function with signature 'const T* (const T* begin, const T* end)'; it scans a segment,
+     *  returning the pointer it stopped at; if that is not the end of the segment, then scanning stops.
+     * @return the position scanning stopped at.
+     */
+    template <class Iterator, class F> Iterator scanSegments(Iterator it, const Iterator& end, const F& scan) {
+        while (it != end) {
+            const size_t size = contiguousSize(it, end);
+            if constexpr (isContiguousIterator<Iterator>()) {
+                const auto* const data = toPointer(it);
+                return it + (scan(data, data + size) - data);
+            }
+            else {
+                const auto* const data = it.segmentData();
+                const auto* const stop = scan(data, data + size);
+                it += stop - data;
+                if (stop != data + size) {
+                    break;
+                }
+            }
+        }
+        return it;
+    }
+
+
+    /**
+     * Returns the number of trailing zero bits of a value.
+     * @param value value; must not be 0.
+     * @return number of trailing zero bits.
+     */
+    inline unsigned countTrailingZeros(unsigned value) {
+        #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<unsigned>(index);
+        #else
+        return static_cast<unsigned>(__builtin_ctz(value));
+        #endif
+    }
+
+
+    /**
+     * Creates a source over a range of another source of the same type; used for the content of matches.
+     * String views are created from a pointer and a length, since they cannot be created from iterators.
+     * @param begin start of range.
+     * @param end end of range.
+     * @return a source over the range.
+     */
+    template <class SourceType, class Iterator> SourceType makeSubSource(const Iterator& begin, const Iterator& end) {
+        if constexpr (IsStringView<SourceType>::value) {
+            return begin == end ? SourceType() : SourceType(toPointer(begin), static_cast<size_t>(end - begin));
+        }
+        else {
+            return SourceType(begin, end);
+        }
+    }
+
+
+    /**
+     * Copies up to the given number of elements of a range into a string; used for error messages.
+     * @param begin start of range.
+     * @param end end of range.
+     * @param len max number of elements to copy.
+     * @return a string with the copied elements.
+     */
+    template <class Iterator>
+    std::basic_string<typename std::iterator_traits<Iterator>::value_type> toSubString(const Iterator& begin, const Iterator& end, size_t len) {
+        return std::basic_string<typename std::iterator_traits<Iterator>::value_type>(begin, std::next(begin, std::min(static_cast<std::ptrdiff_t>(len), std::distance(begin, end))));
     }
 
 
@@ -1,6 +1,8 @@
 #include <cassert>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <filesystem>
 #include "parserlib.hpp"
 
 
@@ -590,6 +592,18 @@ static void unitTest_TreeMatch() {
     stream << match.children()[3].children()[1].content();
     const std::string output = stream.str();
     assert(input == output);
+
+    //tree matches take their children from the context instead of copying them
+    static_assert(std::is_nothrow_move_constructible_v<Match> && std::is_move_assignable_v<Match>);
+    {
+        ParseContext<std::string, TYPE> pc1(input);
+        assert(hexByte(pc1));
+        const Match* const hexDigits = pc1.matches()[0].children().data();
+        pc1.addMatch(IP4_ADDRESS, pc1.matches()[0].begin(), pc1.matches()[0].end(), 1);
+        assert(pc1.matches().size() == 1);
+        assert(pc1.matches()[0].children().size() == 1);
+        assert(pc1.matches()[0].children()[0].children().data() == hexDigits);
+    }
 }
 
 
@@ -1031,6 +1045,1511 @@ static void unitTest_errorRecovery() {
 }
 
 
+static void unitTest_numberParsers() {
+    {
+        const auto parser = integerNumber<int>() == std::string("int");
+
+        {
+            const std::string input = "-12345678901";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(!ok);
+            assert(pc.sourcePosition() == input.begin());
+        }
+
+        {
+            const std::string input = "-2147483648,";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(ok);
+            assert(pc.sourcePosition() == std::prev(input.end()));
+            assert(pc.matches().size() == 1);
+            assert(pc.matches()[0].valueAs<int>() == -2147483648LL);
+        }
+
+        {
+            const std::string input = "x";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(!ok);
+            assert(pc.sourcePosition() == input.begin());
+            assert(pc.errors().size() == 1);
+        }
+    }
+
+    {
+        const auto parser = integerNumber<unsigned long long>() == std::string("int");
+
+        {
+            const std::string input = "18446744073709551615";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(ok);
+            assert(pc.sourceEnded());
+            assert(std::get<unsigned long long>(pc.matches()[0].value()) == 18446744073709551615ULL);
+        }
+
+        {
+            const std::string input = "18446744073709551616";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(!ok);
+            assert(pc.sourcePosition() == input.begin());
+        }
+
+        {
+            const std::string input = "-1";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(!ok);
+        }
+    }
+
+    {
+        const auto parser = hexNumber<unsigned char>() == std::string("hex");
+
+        {
+            const std::string input = "fF";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(ok);
+            assert(pc.matches()[0].valueAs<unsigned>() == 255);
+        }
+
+        {
+            const std::string input = "100";
+            ParseContext pc(input);
+            bool ok = parser(pc);
+            assert(!ok);
+        }
+    }
+
+    {
+        const auto number = floatNumber<double>() == std::string("num");
+        const auto parser = number >> *(',' >> number);
+
+        const std::string input = "1.5,-.25,3e2,7E-1,42,1e";
+        ParseContext pc(input);
+        bool ok = parser(pc);
+        assert(ok);
+        assert(pc.sourcePosition() == std::prev(input.end()));
+        assert(pc.matches().size() == 6);
+        assert(pc.matches()[0].valueAs<double>() == 1.5);
+        assert(pc.matches()[1].valueAs<double>() == -0.25);
+        assert(pc.matches()[2].valueAs<double>() == 300.0);
+        assert(pc.matches()[3].valueAs<double>() == 0.7);
+        assert(pc.matches()[4].valueAs<double>() == 42.0);
+        assert(pc.matches()[5].valueAs<double>() == 1.0);
+    }
+}
+
+
+static void unitTest_skipper() {
+    const Skipper skipper(" \t\r\n", "//", "/*", "*/");
+    const auto letter = terminalRange('a', 'z');
+    const auto identifier = lexeme(+letter) == "id";
+    const auto grammar = skip(skipper, '(' >> identifier >> *(',' >> identifier) >> ')' >> eof());
+
+    {
+        const std::string input = " ( abc ,/* comment */de // line comment\n , f ) ";
+        ParseContext<std::string, std::string, LineCountingSourcePosition<>> pc(input);
+        bool ok = grammar(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 3);
+        assert(pc.matches()[0].content() == "abc");
+        assert(pc.matches()[1].content() == "de");
+        assert(pc.matches()[2].content() == "f");
+        assert(pc.matches()[2].begin().line() == 2);
+        assert(pc.matches()[2].begin().column() == 4);
+        assert(pc.skipper() == nullptr);
+    }
+
+    {
+        const std::string input = "(ab c)";
+        ParseContext pc(input);
+        bool ok = grammar(pc);
+        assert(!ok);
+    }
+
+    {
+        const std::string input = "(abc /* unterminated )";
+        ParseContext pc(input);
+        bool ok = grammar(pc);
+        assert(!ok);
+    }
+
+    {
+        const std::string input = "(                                        a                                        )";
+        ParseContext pc(input);
+        bool ok = grammar(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 1);
+    }
+
+    {
+        const Skipper space(" ");
+        const auto number = skip(space, (+terminalRange('0', '9') == "num") >> ';');
+        const std::string input = "12 ;";
+        ParseContext pc(input);
+        bool ok = number(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 1);
+        assert(pc.matches()[0].content() == "12");
+    }
+
+    {
+        const Skipper space(" ");
+        Rule<> b = terminal('b');
+        const auto grammar = skip(space, (('a' >> -terminal('b') >> *b >> -(integerNumber<int>() == std::string("int")) >> -eof()) == "x") >> ';');
+        const std::string input = "a ;";
+        ParseContext pc(input);
+        bool ok = grammar(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 1);
+        assert(pc.matches()[0].content() == "a");
+    }
+}
+
+
+static void unitTest_binaryParsers() {
+    using Source = std::vector<std::uint8_t>;
+
+    {
+        const auto parser = (binaryBE<std::uint16_t>() == 1) >> (binaryLE<std::int32_t>() == 2) >> (binaryLE<std::uint8_t>() == 3);
+        const Source input{ 0x12, 0x34, 0xFE, 0xFF, 0xFF, 0xFF, 0x80 };
+        ParseContext<Source, int> pc(input);
+        bool ok = parser(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 3);
+        assert(pc.matches()[0].valueAs<unsigned>() == 0x1234);
+        assert(pc.matches()[1].valueAs<int>() == -2);
+        assert(pc.matches()[2].valueAs<unsigned>() == 0x80);
+    }
+
+    {
+        const auto parser = binaryLE<std::uint32_t>();
+        const Source input{ 0x01, 0x02, 0x03 };
+        ParseContext<Source, int> pc(input);
+        bool ok = parser(pc);
+        assert(!ok);
+        assert(pc.sourcePosition() == input.begin());
+    }
+
+    {
+        const auto parser = *(varint<std::uint32_t>() == 1);
+        const Source input{ 0x00, 0x7F, 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0x10 };
+        ParseContext<Source, int> pc(input);
+        bool ok = parser(pc);
+        assert(ok);
+        assert(pc.sourcePosition() == std::next(input.begin(), 9));
+        assert(pc.matches().size() == 4);
+        assert(pc.matches()[0].valueAs<unsigned>() == 0);
+        assert(pc.matches()[1].valueAs<unsigned>() == 127);
+        assert(pc.matches()[2].valueAs<unsigned>() == 300);
+        assert(pc.matches()[3].valueAs<unsigned>() == 0xFFFFFFFF);
+    }
+
+    {
+        const auto parser = (lengthPrefixed(varint<std::uint32_t>()) == 1) >> (binaryBE<std::uint8_t>() == 2);
+        const Source input{ 0x03, 'a', 'b', 'c', 0x2A };
+        ParseContext<Source, int> pc(input);
+        bool ok = parser(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 2);
+        assert(pc.matches()[0].valueAs<size_t>() == 3);
+        assert(pc.matches()[0].content().size() == 4);
+        assert(pc.matches()[1].valueAs<int>() == 42);
+    }
+
+    {
+        const auto parser = lengthPrefixed(binaryLE<std::uint16_t>());
+        const Source input{ 0x05, 0x00, 'a', 'b' };
+        ParseContext<Source, int> pc(input);
+        bool ok = parser(pc);
+        assert(!ok);
+        assert(pc.sourcePosition() == input.begin());
+    }
+}
+
+
+static void unitTest_search() {
+    {
+        const auto parser = terminal("ab") | terminalRange('0', '9') | (-terminal('x') >> 'y');
+        const FirstSet fs = firstSet(parser);
+        assert(fs.contains('a'));
+        assert(!fs.contains('b'));
+        assert(fs.contains('5'));
+        assert(fs.contains('x'));
+        assert(fs.contains('y'));
+        assert(fs.size() == 13);
+        assert(!fs.nullable());
+        assert(firstSet(terminal('a'), false).contains('A'));
+        assert(firstSet(*terminal('a')).nullable());
+    }
+
+    {
+        const std::string input = "abababa";
+        const auto parser = terminal("aba");
+        const auto nonOverlapping = findAll(parser, input);
+        assert(nonOverlapping.size() == 2);
+        assert(nonOverlapping[0].begin() == input.begin());
+        assert(nonOverlapping[1].begin() == std::next(input.begin(), 4));
+        const auto overlapping = findAll(parser, input, SearchMode::Overlapping);
+        assert(overlapping.size() == 3);
+        assert(overlapping[1].begin() == std::next(input.begin(), 2));
+        assert(overlapping[2].end() == input.end());
+    }
+
+    {
+        const std::string input = "ab 12 cd 345 x6";
+        Rule<> number = +terminalRange('0', '9');
+        const auto results = findAll(number, input);
+        assert(results.size() == 3);
+        assert(std::string(results[1].begin().iterator(), results[1].end().iterator()) == "345");
+        assert(results[2].end() == input.end());
+
+        ParseContext<> pc(input);
+        size_t count = search(number == std::string("number"), pc, [](const auto&, const auto&) {});
+        assert(count == 3);
+        assert(pc.matches().size() == 3);
+        assert(pc.matches()[0].content() == "12");
+    }
+
+    {
+        const Skipper skipper;
+        const std::string input = "x = 1;  y=  2 ; z =3";
+        const auto assignment = terminalRange('a', 'z') >> '=' >> terminalRange('0', '9');
+        ParseContext<> pc(input);
+        pc.setSkipper(&skipper);
+        std::vector<size_t> offsets;
+        search(assignment, pc, [&](const auto& begin, const auto&) { offsets.push_back(begin.iterator() - input.begin()); });
+        assert((offsets == std::vector<size_t>{ 0, 8, 16 }));
+    }
+
+    {
+        std::string input;
+        for (size_t index = 0; index < 2000; ++index) {
+            input += std::string(index % 7, '1') + std::string(index % 3 + 1, 'a') + "11";
+        }
+        const auto parser = terminal("11") | terminal("1a");
+        for (const SearchMode mode : { SearchMode::NonOverlapping, SearchMode::Overlapping }) {
+            const auto sequential = findAll(parser, input, mode);
+            for (const size_t threadCount : { 2, 3, 8 }) {
+                const auto parallel = findAll(parser, input, mode, threadCount);
+                assert(parallel.size() == sequential.size());
+                for (size_t index = 0; index < sequential.size(); ++index) {
+                    assert(parallel[index].begin() == sequential[index].begin());
+                    assert(parallel[index].end() == sequential[index].end());
+                }
+            }
+        }
+    }
+}
+
+
+static void unitTest_batch() {
+    const auto digit = terminalRange('0', '9');
+    const auto date = 4 * digit >> '-' >> 2 * digit >> '-' >> 2 * digit >> eof();
+
+    {
+        const std::vector<std::string> inputs{ "2024-01-31", "2024-1-31", "", "1999-12-01", "1999-12-011" };
+        const auto results = parseBatch(date, inputs);
+        assert(results.size() == 5);
+        assert(results[0].success());
+        assert(results[0].endOffset() == 10);
+        assert(results[0].errorType() == -1);
+        assert(!results[1].success());
+        assert(results[1].errorType() == static_cast<int>(ErrorType::SyntaxError));
+        assert(!results[2].success());
+        assert(results[3].success());
+        assert(!results[4].success());
+    }
+
+    {
+        Rule<> identifier = terminalRange('a', 'z') >> *(terminalRange('a', 'z') | digit);
+        const std::vector<std::string> inputs{ "abc1", "1abc", "x" };
+        std::vector<BatchResult> results(inputs.size());
+        parseBatch(identifier, inputs.begin(), inputs.end(), results.begin());
+        assert(results[0].success() && results[0].endOffset() == 4);
+        assert(!results[1].success());
+        assert(results[2].success() && results[2].endOffset() == 1);
+    }
+}
+
+
+static void unitTest_snapshot() {
+    const auto letter = terminalRange('a', 'z');
+    const auto preamble = *(((terminal("#include ") >> +letter) == "include") >> '\n');
+    const auto body = *(((+letter) == "word") >> -terminal(' ')) >> eof();
+
+    const std::string preambleSource = "#include abc\n#include def\n";
+    ParseContext<> preamblePc(preambleSource);
+    bool ok = preamble(preamblePc);
+    assert(ok);
+    const auto snapshot = preamblePc.snapshot();
+    assert(snapshot->sourceOffset() == preambleSource.size());
+    assert(snapshot->matches().size() == 2);
+
+    const std::vector<std::string> documents{ preambleSource + "one two", preambleSource + "three", preambleSource + "4" };
+    std::vector<size_t> wordCounts(documents.size());
+    std::vector<bool> results(documents.size());
+    std::vector<std::thread> threads;
+    for (size_t index = 0; index < documents.size(); ++index) {
+        threads.emplace_back([&, index]() {
+            ParseContext<> pc(documents[index], snapshot);
+            results[index] = body(pc);
+            wordCounts[index] = pc.matches().size();
+            assert(pc.parentSnapshot()->matches()[1].content() == "#include def");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(results[0] && wordCounts[0] == 2);
+    assert(results[1] && wordCounts[1] == 1);
+    assert(!results[2]);
+
+    ParseContext<> pc(documents[0], snapshot);
+    ok = body(pc);
+    assert(ok);
+    const auto fullSnapshot = pc.snapshot();
+    assert(fullSnapshot->matches().size() == 4);
+    assert(fullSnapshot->matches()[3].content() == "two");
+    assert(fullSnapshot->sourceOffset() == documents[0].size());
+
+    //forked positions keep the line and column of the snapshot
+    {
+        using PC = ParseContext<std::string, std::string, LineCountingSourcePosition<>>;
+        PC linePc(preambleSource);
+        assert(preamble(linePc));
+        const auto lineSnapshot = linePc.snapshot();
+        PC forkedPc(documents[0], lineSnapshot);
+        assert(forkedPc.sourcePosition().iterator() == documents[0].begin() + preambleSource.size());
+        assert(forkedPc.sourcePosition().line() == 3);
+        assert(forkedPc.sourcePosition().column() == 1);
+        assert(body(forkedPc));
+        assert(forkedPc.matches()[1].begin().line() == 3);
+        assert(forkedPc.matches()[1].begin().column() == 5);
+    }
+}
+
+
+static void unitTest_matchDag() {
+    const auto digit = terminalRange('0', '9') == std::string("digit");
+    const auto record = (terminal('(') >> (+digit >= std::string("key")) >> '=' >> (+digit >= std::string("value")) >> ')') >= std::string("record");
+    const auto grammar = *record >> eof();
+
+    std::string input;
+    for (size_t index = 0; index < 100; ++index) {
+        input += index % 2 ? "(12=345)" : "(7=7)";
+    }
+    ParseContext<> pc(input);
+    bool ok = grammar(pc);
+    assert(ok);
+    assert(pc.matches().size() == 100);
+
+    MatchDag<ParseContext<>::MatchType> dag;
+    dag.add(pc.matches(), input.begin());
+    assert(dag.roots().size() == 100);
+    assert(dag.offsets().size() == 50 * 8 + 50 * 5);
+    assert(dag.nodes().size() == 12);
+    assert(MatchDag<ParseContext<>::MatchType>::equal(dag.roots()[0], dag.roots()[2]));
+    assert(!MatchDag<ParseContext<>::MatchType>::equal(dag.roots()[0], dag.roots()[1]));
+
+    const auto& root = dag.node(dag.roots()[1]);
+    assert(root.id() == "record");
+    assert(root.content() == "(12=345)");
+    assert(root.subtreeSize() == 8);
+    const auto& root0 = dag.node(dag.roots()[0]);
+    assert(dag.node(root0.children()[0]).children()[0] == dag.node(root0.children()[1]).children()[0]);
+
+    size_t index = 0;
+    dag.forEach([&](const auto& node, size_t begin, size_t end, size_t depth) {
+        const auto& match = pc.matches()[1];
+        if (index == 5) {
+            assert(node.id() == match.id());
+            assert(begin == 5);
+            assert(end == 13);
+            assert(depth == 0);
+        }
+        ++index;
+    });
+    assert(index == dag.offsets().size());
+
+    //nodes with the same children differ by the elements between the children and by their placement
+    {
+        const auto gapped = (-terminalSet('a', 'b') >> (terminal('x') == std::string("x")) >> -terminalSet('a', 'b')) >= std::string("gapped");
+        const std::string gappedInput = "ax,xa,bx,ax,axa";
+        ParseContext<> pc1(gappedInput);
+        assert((gapped >> *(',' >> gapped) >> eof())(pc1));
+        assert(pc1.matches().size() == 5);
+
+        MatchDag<ParseContext<>::MatchType> dag1;
+        dag1.add(pc1.matches(), gappedInput.begin());
+        assert(dag1.nodes().size() == 5);
+        assert(dag1.roots()[0] == dag1.roots()[3]);
+        assert(dag1.roots()[0] != dag1.roots()[1] && dag1.roots()[0] != dag1.roots()[2]);
+        assert(dag1.node(dag1.roots()[1]).content() == "xa");
+        assert(dag1.node(dag1.roots()[4]).content() == "axa");
+        assert(dag1.node(dag1.roots()[4]).length() == 3);
+    }
+}
+
+
+static void unitTest_flatMatch() {
+    enum Id { DIGIT, NUMBER, LIST };
+    const auto number = +(terminalRange('0', '9') == DIGIT) >= NUMBER;
+    const auto grammar = (number >> *(',' >> number)) >= LIST;
+
+    const std::string input = "12,345,6";
+    ParseContext<std::string, Id> pc(input);
+    bool ok = grammar(pc);
+    assert(ok);
+
+    const size_t size = flatMatchSize(pc.matches());
+    assert(size == sizeof(FlatMatchHeader) + 10 * sizeof(FlatMatchRecord));
+    std::vector<std::uint64_t> region(size / sizeof(std::uint64_t));
+    assert(writeFlatMatches(pc.matches(), input.begin(), region.data(), size - 1) == 0);
+    assert(writeFlatMatches(pc.matches(), input.begin(), region.data(), size) == size);
+
+    //the region is relocatable
+    const std::vector<std::uint64_t> copy(region);
+    const FlatMatchView view(copy.data(), size);
+    assert(view.size() == 10);
+    assert(view.rootCount() == 1);
+    assert(view[0].id() == LIST);
+    assert(view[0].childCount() == 3);
+    assert(view[0].subtreeSize() == 10);
+    const size_t second = view.nextSibling(view.firstChild(0));
+    assert(view[second].id() == NUMBER);
+    assert(view[second].begin() == 3 && view[second].end() == 6);
+    assert(view[second].childCount() == 3);
+    assert(view[view.nextSibling(second)].begin() == 7);
+    assert(view.nextSibling(view.nextSibling(second)) == view.size());
+
+    bool thrown = false;
+    try {
+        FlatMatchView invalid(copy.data(), sizeof(FlatMatchHeader) + sizeof(FlatMatchRecord));
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    //corrupted records are rejected
+    const auto corruptionThrows = [&](size_t recordIndex, size_t fieldIndex, std::uint64_t value) {
+        std::vector<std::uint64_t> corrupted(copy);
+        corrupted[(sizeof(FlatMatchHeader) + recordIndex * sizeof(FlatMatchRecord)) / sizeof(std::uint64_t) + fieldIndex] = value;
+        try {
+            FlatMatchView invalid(corrupted.data(), size);
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    assert(!corruptionThrows(1, 0, NUMBER));
+    assert(corruptionThrows(1, 4, 0));
+    assert(corruptionThrows(0, 4, 11));
+    assert(corruptionThrows(1, 4, 4));
+    assert(corruptionThrows(0, 3, 2));
+    assert(corruptionThrows(0, 3, 4));
+    assert(corruptionThrows(9, 3, 1));
+
+    ParseContext<> pc2(input);
+    const auto stringIdNumber = (+terminalRange('0', '9')) == std::string("number");
+    ok = (stringIdNumber >> *(',' >> stringIdNumber))(pc2);
+    assert(ok);
+    std::vector<std::uint64_t> region2(flatMatchSize(pc2.matches()) / sizeof(std::uint64_t));
+    writeFlatMatches(pc2.matches(), input.begin(), region2.data(), region2.size() * sizeof(std::uint64_t), [](const std::string& id) { return id.size(); });
+    const FlatMatchView view2(region2.data(), region2.size() * sizeof(std::uint64_t));
+    assert(view2.size() == 3);
+    assert(view2.rootCount() == 3);
+    assert(view2[1].id() == 6);
+}
+
+
+static void unitTest_flatMatchStore() {
+    enum Id { KEY, VALUE, RECORD };
+    const auto digits = +terminalRange('0', '9');
+    const auto record = ((digits == KEY) >> '=' >> (digits == VALUE) >> ';') >= RECORD;
+
+    std::string input;
+    for (size_t index = 0; index < 1000; ++index) {
+        input += std::to_string(index) + '=' + std::to_string(index * 2) + ';';
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "parserlib_unitTest_flatMatchStore.bin").string();
+    {
+        FlatMatchFileStore store(path);
+        ParseContext<std::string, Id> pc(input);
+        ErrorContainer<ParseContext<std::string, Id>::PositionType> errors;
+        bool ok = parseToStore(memo(record), pc, store, errors);
+        assert(ok);
+        assert(errors.empty());
+        assert(pc.matches().empty());
+        assert(pc.memoTable().size() == 1);
+        assert(store.rootCount() == 1000);
+        assert(store.recordCount() == 3000);
+        store.close();
+    }
+
+    {
+        const FlatMatchFileView file(path);
+        const FlatMatchView& view = file.view();
+        assert(view.size() == 3000);
+        assert(view.rootCount() == 1000);
+        size_t rootIndex = 0;
+        for (size_t index = 0; index < view.size(); index = view.nextSibling(index), ++rootIndex) {
+            assert(view[index].id() == RECORD);
+            assert(view[index].childCount() == 2);
+            const auto& value = view[view.nextSibling(view.firstChild(index))];
+            assert(value.id() == VALUE);
+            assert(input.substr(static_cast<size_t>(value.begin()), static_cast<size_t>(value.end() - value.begin())) == std::to_string(rootIndex * 2));
+        }
+        assert(rootIndex == 1000);
+    }
+
+    //the errors of items recovered by error recovery are kept
+    {
+        const auto recoveredRecord = ((digits == KEY) >> '=' >> (digits == VALUE) >> ~terminal(';')) >= RECORD;
+        const std::string errorInput = "1=2;3=x;5=6;7=y;9=8;";
+        FlatMatchFileStore store(path);
+        ParseContext<std::string, Id> pc(errorInput);
+        ErrorContainer<ParseContext<std::string, Id>::PositionType> errors;
+        bool ok = parseToStore(recoveredRecord, pc, store, errors);
+        assert(ok);
+        assert(errors.size() == 2);
+        assert(errors[0].position().iterator() == std::next(errorInput.begin(), 6));
+        assert(errors[1].position().iterator() == std::next(errorInput.begin(), 14));
+        assert(store.rootCount() == 5);
+        store.close();
+    }
+
+    std::filesystem::remove(path);
+}
+
+
+static void unitTest_rope() {
+    const std::string whitespace(40, ' ');
+    const std::vector<std::string> buffers{ "le", "t" + whitespace, whitespace + "ab", "c = 1234", "56789", "", "0;   let de = 7;" };
+    const RopeSource<> source({ buffers[0], buffers[1], buffers[2], buffers[3], buffers[4], buffers[5], buffers[6] });
+
+    {
+        assert(source.size() == 2 + 41 + 42 + 8 + 5 + 16);
+        assert(source.pieceCount() == 7);
+        std::string concatenated;
+        for (const std::string& buffer : buffers) {
+            concatenated += buffer;
+        }
+        assert(source.toString() == concatenated);
+        assert(std::string(source.begin(), source.end()) == concatenated);
+        assert(std::equal(concatenated.rbegin(), concatenated.rend(), std::make_reverse_iterator(source.end())));
+        assert(source.end() - source.begin() == static_cast<std::ptrdiff_t>(source.size()));
+        auto it = source.begin() + 98;
+        assert(it.pieceIndex() == 6);
+        assert(it.pieceOffset() == 0);
+        assert(*it == '0');
+        it -= 6;
+        assert(it.pieceIndex() == 3);
+        assert(it.pieceOffset() == 7);
+        assert(source.begin()[85] == 'c');
+    }
+
+    {
+        const Skipper skipper;
+        const auto identifier = lexeme(+terminalRange('a', 'z')) == std::string("id");
+        const auto number = integerNumber<long long>() == std::string("number");
+        const auto statement = terminal("let") >> identifier >> '=' >> number >> ';';
+        const auto grammar = skip(skipper, *statement >> eof());
+
+        ParseContext<RopeSource<>> pc(source);
+        bool ok = grammar(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 4);
+        assert(pc.matches()[0].content().toString() == "abc");
+        assert(pc.matches()[0].content().pieceCount() == 2);
+        assert(pc.matches()[0].begin().iterator().pieceIndex() == 2);
+        assert(pc.matches()[0].begin().iterator().pieceOffset() == 40);
+        assert(pc.matches()[0].end().iterator().pieceIndex() == 3);
+        assert(pc.matches()[1].valueAs<long long>() == 1234567890LL);
+        assert(pc.matches()[1].content().pieceCount() == 3);
+        assert(pc.matches()[2].content().toString() == "de");
+        assert(pc.matches()[3].valueAs<long long>() == 7);
+    }
+
+    {
+        const auto parser = terminal("let") | terminal('=');
+        const auto results = findAll<ParseContext<RopeSource<>>>(parser, source);
+        assert(results.size() == 4);
+        assert(results[0].begin().iterator().pieceIndex() == 0);
+        assert(results[0].end().iterator().pieceIndex() == 1);
+        assert(results[2].begin().iterator().pieceIndex() == 6);
+        assert(results[2].begin().iterator().pieceOffset() == 5);
+    }
+
+    //a sub-rope references the same buffers, with its own piece table
+    {
+        const std::string first = "abc";
+        const std::string second = "de";
+        RopeSource<> rope({ first });
+        for (size_t index = 0; index < 100; ++index) {
+            rope.append(second);
+        }
+        assert(rope.size() == 203);
+
+        const RopeSource<> content(rope.begin() + 1, rope.begin() + 5);
+        assert(std::string(content.begin(), content.end()) == "bcde");
+        assert(content.pieceCount() == 2);
+        assert(content.begin().pieceIndex() == 0);
+        assert(content.piece(0).data() == first.data() + 1);
+    }
+}
+
+
+static void unitTest_viewSources() {
+    const Skipper skipper;
+    const auto identifier = lexeme(+terminalRange('a', 'z')) == std::string("id");
+    const auto value = integerNumber<int>() == std::string("value");
+    const auto statement = terminal("let") >> identifier >> '=' >> value >> terminalSet(';', ',');
+    const auto grammar = skip(skipper, *statement >> eof());
+
+    {
+        const std::string_view input = "let abc = 1; let de=23,";
+        ParseContext<std::string_view> pc(input);
+        bool ok = grammar(pc);
+        assert(ok);
+        assert(pc.matches().size() == 4);
+        assert(pc.matches()[0].content() == "abc");
+        assert(pc.matches()[0].content().data() == input.data() + 4);
+        assert(pc.matches()[3].valueAs<int>() == 23);
+    }
+
+    {
+        const std::string_view input = "let abc = 1; lex";
+        ParseContext<std::string_view> pc(input);
+        bool ok = grammar(pc);
+        assert(!ok);
+        assert(pc.sourcePosition() == input.begin());
+    }
+
+    {
+        const std::string text = "let abc = 1; let de=23, let";
+        const std::string buffer = text + std::string(PaddedSource<>::padding, '\0');
+        const PaddedSource<> input(buffer.data(), text.size());
+
+        ParseContext<PaddedSource<>> pc(input);
+        bool ok = grammar(pc);
+        assert(!ok);
+        assert(pc.sourcePosition() == input.begin());
+
+        const PaddedSource<> complete(buffer.data(), text.size() - 4);
+        pc.reset(complete);
+        ok = grammar(pc);
+        assert(ok);
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 4);
+        assert(pc.matches()[2].content() == "de");
+    }
+
+    {
+        const std::string buffer(PaddedSource<>::padding + 2, '\0');
+        const PaddedSource<> input(buffer.data(), 2);
+        ParseContext<PaddedSource<>> pc(input);
+        assert(terminal('\0')(pc));
+        assert(terminalSet('a', '\0')(pc));
+        assert(!terminal('\0')(pc));
+        assert(!terminalSet('a', '\0')(pc));
+        assert(!terminalRange('\0', 'z')(pc));
+        assert(!terminal("abcdefghijk")(pc));
+        assert(pc.sourceEnded());
+    }
+
+    {
+        const std::string text = "abcdefgh";
+        const std::string buffer = text + std::string(PaddedSource<>::padding, '\0');
+        const PaddedSource<> input(buffer.data(), text.size());
+        ParseContext<PaddedSource<>> pc(input);
+        assert((terminal('a') == std::string("a"))(pc));
+
+        const auto content = pc.matches()[0].content();
+        assert(content == "a");
+
+        ParseContext<decltype(content)> pc1(content);
+        assert(!terminal("abcdefgh")(pc1));
+        assert(!(terminal('a') >> 'b')(pc1));
+        assert(pc1.sourcePosition() == content.begin());
+        assert((terminal('a') >> eof())(pc1));
+    }
+
+    #ifdef PARSERLIB_CPP20
+    {
+        const std::vector<int> data{ 1, 2, 3, 4 };
+        const std::span<const int> input(data);
+        ParseContext<std::span<const int>> pc(input);
+        const auto parser = (terminal(1) >> terminal(2)) == std::string("pair");
+        assert(parser(pc));
+        assert(pc.matches()[0].content().size() == 2);
+    }
+    #endif
+}
+
+
+static void unitTest_list() {
+    const auto digit = terminalRange('0', '9') == std::string("digit");
+
+    {
+        const std::string input = "1,2,3";
+        ParseContext<> pc(input);
+        assert(list(digit, ',')(pc));
+        assert(pc.sourceEnded());
+        assert(pc.matches().size() == 3);
+        assert(pc.matches()[2].content() == "3");
+    }
+
+    {
+        const std::string input = "1,2,";
+        ParseContext<> pc1(input);
+        assert(list(digit, ',')(pc1));
+        assert(pc1.sourcePosition() == std::next(input.begin(), 3));
+        assert(pc1.matches().size() == 2);
+
+        ParseContext<> pc2(input);
+        assert(list(digit, ',', 1, std::numeric_limits<size_t>::max(), true)(pc2));
+        assert(pc2.sourceEnded());
+        assert(pc2.matches().size() == 2);
+    }
+
+    {
+        const auto parser = list(digit, terminal(';') >> *terminal(' '), 2, 3);
+
+        const std::string input1 = "1";
+        ParseContext<> pc1(input1);
+        assert(!parser(pc1));
+        assert(pc1.sourcePosition() == input1.begin());
+        assert(pc1.matches().empty());
+
+        const std::string input2 = "1; 2;  3;4";
+        ParseContext<> pc2(input2);
+        assert(parser(pc2));
+        assert(pc2.sourcePosition() == std::next(input2.begin(), 8));
+        assert(pc2.matches().size() == 3);
+    }
+
+    {
+        const std::string input = "x";
+        ParseContext<> pc(input);
+        assert(list(digit, ',', 0)(pc));
+        assert(pc.sourcePosition() == input.begin());
+        assert(firstSet(list(digit, ',', 0)).nullable());
+        assert(!firstSet(list(digit, ',')).nullable());
+    }
+
+    {
+        std::string input;
+        for (size_t index = 0; index < 1000; ++index) {
+            input += (index ? "," : "") + std::to_string(index % 10);
+        }
+        ParseContext<> pc(input);
+        assert((list(digit, ',') >> eof())(pc));
+        assert(pc.matches().size() == 1000);
+        assert(pc.matches()[999].content() == "9");
+    }
+
+    {
+        bool thrown = false;
+        try {
+            list(digit, ',', 3, 2);
+        }
+        catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
+
+static void unitTest_lookahead() {
+    using PC = ParseContext<>;
+    static_assert(CanPeek<decltype(terminal('a')), PC>::value);
+    static_assert(CanPeek<decltype(terminal("ab") | terminalSet('x', 'y') | eof()), PC>::value);
+    static_assert(CanPeek<decltype(!terminalRange('0', '9')), PC>::value);
+    static_assert(!CanPeek<decltype(terminal('a') >> 'b'), PC>::value);
+    static_assert(!CanPeek<decltype(terminal('a') == std::string("a")), PC>::value);
+
+    {
+        const std::string input = "abc'd";
+        const auto parser = *(terminalRange('a', 'z') - '\'') == std::string("text");
+        PC pc(input);
+        assert(parser(pc));
+        assert(pc.sourcePosition() == std::next(input.begin(), 3));
+        assert(pc.matches().size() == 1);
+        assert(pc.errors().empty());
+    }
+
+    {
+        const std::string input = "ab";
+        PC pc(input);
+        assert((&terminal("ab"))(pc));
+        assert(!(!terminal("ab"))(pc));
+        assert((!(terminal('x') | terminal("abc")))(pc));
+        assert(pc.sourcePosition() == input.begin());
+        assert(pc.errors().empty());
+    }
+
+    {
+        const Skipper skipper;
+        const std::string input = "  x  ";
+        PC pc(input);
+        pc.setSkipper(&skipper);
+        assert((&terminal('x'))(pc));
+        assert(pc.sourcePosition() == input.begin());
+        assert(terminal('x')(pc));
+        assert((&eof())(pc));
+        assert(pc.sourcePosition() == std::next(input.begin(), 3));
+        assert(eof()(pc));
+        assert(pc.sourceEnded());
+    }
+
+    {
+        const std::string input = "a";
+        PC pc(input);
+        assert((!(terminal('a') >> 'b'))(pc));
+        assert(pc.sourcePosition() == input.begin());
+        assert(pc.errors().empty());
+    }
+}
+
+
+static void unitTest_adaptiveChoice() {
+    using PC = ParseContext<>;
+
+    {
+        const auto parser = adaptive(terminal('a') | terminal("bc") | terminalRange('0', '9'));
+        assert(parser.reorderable());
+        assert(parser.order() == (std::vector<size_t>{ 0, 1, 2 }));
+
+        const std::string input = "7bc";
+        PC pc(input);
+        assert(parser(pc));
+        assert(parser(pc));
+        assert(!parser(pc));
+        assert(pc.sourcePosition() == input.end());
+        assert(parser.statistics() == (std::vector<std::uint64_t>{ 0, 1, 1 }));
+
+        auto trained = parser;
+        trained.setStatistics({ 1, 3, 5 });
+        assert(parser.order() == (std::vector<size_t>{ 2, 1, 0 }));
+    }
+
+    {
+        auto parser = adaptive(terminal('a') | terminal("ab") | terminal('c'), false);
+        assert(!parser.reorderable());
+        parser.setStatistics({ 0, 10, 0 });
+        const std::string input = "ab";
+        PC pc(input);
+        assert(parser(pc));
+        assert(pc.sourcePosition() == std::next(input.begin(), 1));
+    }
+
+    {
+        const auto parser = adaptive(terminal('a') | -terminal('b'));
+        assert(!parser.reorderable());
+    }
+
+    {
+        //the alternatives are disjoint only case sensitively; they are not reordered in either case mode
+        const auto parser = adaptive(terminalRange('a', 'z') | terminalRange('A', 'Z'));
+        const std::string input = "aB";
+        PC pc(input);
+        assert(parser(pc));
+        assert(!parser.reorderable());
+        ParseContext<std::string, std::string, SourcePosition<std::string, false>> ipc(input);
+        assert(parser(ipc));
+        assert(parser(ipc));
+        assert(ipc.sourceEnded());
+    }
+
+    {
+        const auto parser = adaptive((terminalRange('0', '9') == std::string("digit")) | (terminalRange('a', 'z') == std::string("letter")));
+        const std::string input = "a1b2c3d";
+        PC pc(input);
+        const auto start = pc.sourcePosition();
+        for (size_t count = 0; count < 2 * parser.ReorderInterval; ++count) {
+            assert(parser(pc));
+            if (pc.sourceEnded()) {
+                pc.setSourcePosition(start);
+            }
+        }
+        assert(pc.matches().size() == 2 * parser.ReorderInterval);
+        assert(parser.order() == (std::vector<size_t>{ 1, 0 }));
+        for (size_t index = 0; index < input.size(); ++index) {
+            assert(pc.matches()[index].id() == (index % 2 ? "digit" : "letter"));
+        }
+    }
+}
+
+
+static void unitTest_predictive() {
+    using PC = ParseContext<>;
+
+    const auto number = +terminalRange('0', '9') == std::string("number");
+    const auto name = +terminalRange('a', 'z') == std::string("name");
+    const auto value = number | name;
+    const auto grammar = value >> *(terminal(',') >> value) >> eof();
+    const auto predictiveGrammar = predictive(grammar);
+    assert(predictiveGrammar.certified());
+    assert(predictiveGrammar.certificate().predictiveCount() == 7);
+
+    for (const std::string input : { "12,ab,3", "12,,3", "12,ab,", "", "x" }) {
+        PC pc1(input);
+        PC pc2(input);
+        const bool result1 = grammar(pc1);
+        const bool result2 = predictiveGrammar(pc2);
+        assert(result1 == result2);
+        assert(pc1.sourcePosition() == pc2.sourcePosition());
+        assert(pc1.matches().size() == pc2.matches().size());
+        for (size_t index = 0; index < pc1.matches().size(); ++index) {
+            assert(pc1.matches()[index].id() == pc2.matches()[index].id());
+            assert(pc1.matches()[index].content() == pc2.matches()[index].content());
+        }
+    }
+
+    {
+        const Skipper skipper;
+        const std::string input = " 12 , ab ";
+        PC pc(input);
+        pc.setSkipper(&skipper);
+        assert(predictiveGrammar(pc));
+        assert(pc.matches().size() == 2);
+        assert(pc.matches()[0].content() == "12");
+    }
+
+    {
+        const Rule<> list = predictive('[' >> -((number | list) >> *(',' >> (number | list))) >> ']') == std::string("list");
+        const Rule<> backtrackingList = ('[' >> -((number | backtrackingList) >> *(',' >> (number | backtrackingList))) >> ']') == std::string("list");
+        const std::string input = "[1,[2,[]],3]";
+        PC pc1(input);
+        PC pc2(input);
+        assert(backtrackingList(pc1));
+        assert(list(pc2));
+        assert(pc2.sourceEnded());
+        assert(pc1.matches().size() == pc2.matches().size());
+        for (size_t index = 0; index < pc1.matches().size(); ++index) {
+            assert(pc1.matches()[index].content() == pc2.matches()[index].content());
+        }
+    }
+
+    {
+        //the loop may be followed by what it starts with
+        const auto parser = predictive(*terminal('a') >> terminal("ab"));
+        assert(!parser.certified());
+        assert(parser.certificate().guardedCount() == 1);
+        const std::string input = "aab";
+        PC pc(input);
+        assert(!parser(pc));
+        assert(pc.sourcePosition() == input.begin());
+    }
+
+    {
+        const auto parser = predictive(terminal("ab") | terminal("ac"));
+        assert(parser.certificate().backtrackingCount() == 1);
+        const std::string input = "ac";
+        PC pc(input);
+        assert(parser(pc));
+        assert(pc.sourceEnded());
+    }
+
+    {
+        //the choice and the optional may be followed by anything
+        const auto parser = predictive((terminal('a') >> 'b') | -terminal('c'));
+        assert(parser.certificate().guardedCount() == 2);
+        const std::string input = "ax";
+        PC pc(input);
+        assert(parser(pc));
+        assert(pc.sourcePosition() == input.begin());
+    }
+
+    {
+        //the alternatives are disjoint only case sensitively; the analysis is in the case mode of the first parse
+        const auto letters = +(terminalRange('a', 'z') | terminalRange('A', 'Z')) >> eof();
+        const auto parser1 = predictive(letters);
+        const auto parser2 = predictive(letters);
+        using IPC = ParseContext<std::string, std::string, SourcePosition<std::string, false>>;
+        const std::string input = "abCD";
+        PC pc(input);
+        IPC ipc1(input);
+        IPC ipc2(input);
+        assert(parser1(pc));
+        assert(parser1.certified());
+        assert(parser1(ipc1));
+        assert(parser2(ipc2));
+        assert(!parser2.certified());
+        assert(parser2.certificate().backtrackingCount() == 1);
+    }
+}
+
+
+static void unitTest_memo() {
+    using PC = ParseContext<>;
+
+    //without memoization, each level parses the next one twice
+    const Rule<> r1 = ('x' >> r1 >> 'a' | 'x' >> r1 >> 'b' | 'x') == std::string("r");
+    const Rule<> r2 = ('x' >> memo(r2) >> 'a' | 'x' >> memo(r2) >> 'b' | 'x') == std::string("r");
+
+    {
+        const std::string input = "xxxxxxxxbbbbbbb";
+        PC pc1(input);
+        PC pc2(input);
+        assert(r1(pc1));
+        assert(r2(pc2));
+        assert(pc1.sourcePosition() == pc2.sourcePosition());
+        assert(pc1.matches().size() == pc2.matches().size());
+        for (size_t index = 0; index < pc1.matches().size(); ++index) {
+            assert(pc1.matches()[index].content() == pc2.matches()[index].content());
+        }
+    }
+
+    {
+        const std::string input = std::string(200, 'x') + std::string(199, 'b');
+        PC pc(input);
+        assert(r2(pc));
+        assert(pc.sourceEnded());
+        assert(pc.memoTable().size() == 200);
+        pc.reset(input);
+        assert(pc.memoTable().size() == 0);
+    }
+
+    {
+        const std::string input = "xxc";
+        PC pc1(input);
+        PC pc2(input);
+        assert(r1(pc1));
+        assert(r2(pc2));
+        assert(pc2.sourcePosition() == std::next(input.begin(), 1));
+        assert(pc1.errors().size() == pc2.errors().size());
+    }
+
+    //left recursion is resolved as without memoization
+    {
+        const Rule<> add = memo(add) >> '+' >> terminalRange('0', '9') | terminalRange('0', '9');
+        const std::string input = "1+2+3";
+        PC pc(input);
+        assert(add(pc));
+        assert(pc.sourceEnded());
+    }
+}
+
+
+template <class PC, class P1, class P2> static void assertSameParse(const P1& parser1, const P2& parser2, const typename PC::SourceType& input, const Skipper* skipper = nullptr) {
+    PC pc1(input);
+    PC pc2(input);
+    pc1.setSkipper(skipper);
+    pc2.setSkipper(skipper);
+    assert(parser1(pc1) == parser2(pc2));
+    assert(pc1.sourcePosition() == pc2.sourcePosition());
+    assert(pc1.matches().size() == pc2.matches().size());
+    for (size_t index = 0; index < pc1.matches().size(); ++index) {
+        assert(pc1.matches()[index].id() == pc2.matches()[index].id());
+        assert(pc1.matches()[index].content() == pc2.matches()[index].content());
+    }
+    assert(pc1.errors().size() == pc2.errors().size());
+    for (size_t index = 0; index < pc1.errors().size(); ++index) {
+        assert(pc1.errors()[index].position() == pc2.errors()[index].position());
+        assert(pc1.errors()[index].message() == pc2.errors()[index].message());
+    }
+}
+
+
+static void unitTest_compile() {
+    using PC = ParseContext<>;
+
+    const auto letter = terminalRange('a', 'z') | terminalRange('A', 'Z') | '_';
+    const auto digit = terminalRange('0', '9');
+    const auto identifier = (letter >> *(letter | digit)) == std::string("identifier");
+    const auto number = (+digit >> -('.' >> +digit)) == std::string("number");
+    const auto op = terminalSet('+', '-', '*', '/') == std::string("op");
+    const auto grammar = *(identifier | number | op) >> eof();
+    const auto compiled = compile(grammar);
+
+    static_assert(IsCharClass<std::decay_t<decltype(letter)>>::value);
+    static_assert(!IsCharClass<decltype(terminal("ab") | 'c')>::value);
+    static_assert(std::is_same_v<decltype(compile(*digit)), CharClassLoopParser<Loop0Parser<TerminalRangeParser<char>>, TerminalRangeParser<char>, 0>>);
+    assert(compile(letter).table().contains<true>('Q'));
+    assert(!compile(letter).table().contains<true>('1'));
+    assert(compile(terminal('a') | 'b').table().contains<false>('B'));
+    assert(!compile(terminal('a') | 'b').table().contains<true>('B'));
+
+    const Skipper skipper;
+    for (const std::string input : { "abc+x_1*12.5", "a1b2/3.14", "", "abc?", "12.x", "x+ 3" }) {
+        assertSameParse<PC>(grammar, compiled, input);
+        assertSameParse<PC>(grammar, compiled, input, &skipper);
+    }
+
+    assertSameParse<ParseContext<std::string, std::string, SourcePosition<std::string, false>>>(+(terminal('a') | 'b'), compile(+(terminal('a') | 'b')), std::string("aBAbc"));
+    assertSameParse<ParseContext<std::string, std::string, LineCountingSourcePosition<std::string>>>(*terminalSet('\n', 'x'), compile(*terminalSet('\n', 'x')), std::string("x\nx\nxy"));
+    assertSameParse<ParseContext<std::vector<int>>>(+terminalRange('a', 'z'), compile(+terminalRange('a', 'z')), std::vector<int>{ 'a', 'b', 300 });
+}
+
+
+static void unitTest_boundary() {
+    using PC = ParseContext<>;
+
+    const auto digit = terminalRange('0', '9');
+    const auto number = (+digit >> -('.' >> +digit)) == std::string("number");
+    const auto identifier = ((terminalRange('a', 'z') | '_') >> *(terminalRange('a', 'z') | '_' | digit)) == std::string("identifier");
+    const auto grammar = *((identifier >> '=' >> number >> ';') | (terminal("print") >> identifier >> ';')) >> eof();
+
+    static_assert(std::is_same_v<decltype(boundary(number)), BoundaryParser<PC>>);
+    static_assert(ParserNodeCount<decltype(number)>::value == 9);
+    static_assert(ParserNodeCount<decltype(bounded<PC, 4>(grammar))>::value <= 4 * 2 + 1);
+    assert(firstSet(boundary(number)).contains('7'));
+    assert(!firstSet(boundary(number)).contains('a'));
+
+    for (const std::string input : { "a=1;print a;b_2=3.5;", "a=1;print 2;", "a=1", "" }) {
+        assertSameParse<PC>(grammar, boundary(grammar), input);
+        assertSameParse<PC>(grammar, bounded<PC, 4>(grammar), input);
+        assertSameParse<PC>(grammar, bounded<PC, 1>(grammar), input);
+    }
+
+    //left recursion through a boundary
+    {
+        const Rule<> add1 = (add1 >> '+' >> digit | digit) == std::string("add");
+        const Rule<> add2 = boundary(add2 >> '+' >> digit | digit) == std::string("add");
+        const std::string input = "1+2+3";
+        assertSameParse<PC>(add1, add2, input);
+        PC pc(input);
+        assert(add2(pc));
+        assert(pc.sourceEnded());
+    }
+}
+
+
+static void unitTest_symbols() {
+    using PC = ParseContext<>;
+    const Skipper skipper;
+
+    SymbolTable<> table;
+    const auto letter = terminalRange('a', 'z') | '_';
+    const auto identifier = symbol(lexeme(letter >> *(letter | terminalRange('0', '9'))), table) == std::string("identifier");
+    const auto grammar = *(identifier | ',') >> eof();
+
+    {
+        const std::string input = "foo, bar,foo , x1,bar";
+        PC pc(input);
+        pc.setSkipper(&skipper);
+        assert(grammar(pc));
+        assert(pc.matches().size() == 5);
+        assert(table.size() == 3);
+        for (const auto& match : pc.matches()) {
+            assert(table.symbol(match.valueAs<size_t>()) == match.content());
+        }
+        assert(pc.matches()[0].valueAs<size_t>() == pc.matches()[2].valueAs<size_t>());
+        assert(pc.matches()[1].valueAs<size_t>() == pc.matches()[4].valueAs<size_t>());
+        assert(table.intern(std::string_view("x1")) == pc.matches()[3].valueAs<size_t>());
+    }
+
+    {
+        const std::string input = "1";
+        PC pc(input);
+        assert(!symbol(terminal('a'), table)(pc));
+        assert(table.size() == 3);
+    }
+
+    //concurrent interning into a shared table
+    {
+        SymbolTable<> sharedTable;
+        const auto sharedIdentifier = symbol(lexeme(+letter), sharedTable) == std::string("identifier");
+        const std::string input = "a b c d e f g h a b c d";
+        std::vector<std::vector<size_t>> ids(4);
+        std::vector<std::thread> threads;
+        for (size_t index = 0; index < ids.size(); ++index) {
+            threads.emplace_back([&, index]() {
+                PC pc(input);
+                pc.setSkipper(&skipper);
+                (*sharedIdentifier)(pc);
+                for (const auto& match : pc.matches()) {
+                    ids[index].push_back(match.valueAs<size_t>());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(sharedTable.size() == 8);
+        for (const auto& threadIds : ids) {
+            assert(threadIds == ids[0]);
+            assert(threadIds.size() == 12);
+            assert(threadIds[0] == threadIds[8]);
+        }
+    }
+}
+
+
+static void unitTest_matchIndex() {
+    const auto digit = terminalRange('0', '9') == std::string("digit");
+    const auto record = (terminal('(') >> (+digit >= std::string("key")) >> '=' >> (+digit >= std::string("value")) >> ')') >= std::string("record");
+    const auto grammar = *(record >> -terminal(' ')) >> eof();
+
+    const std::string input = "(12=345) (7=7) (0=12)";
+    ParseContext<> pc(input);
+    assert(grammar(pc));
+    assert(pc.matches().size() == 3);
+
+    const MatchIndex<ParseContext<>::MatchType> index(pc.matches(), input.begin());
+    assert(index.size() == 3 * 3 + 10);
+    assert(index.byId("record").size() == 3);
+    assert(index.byId("digit").size() == 10);
+    assert(index.byId("unknown").empty());
+
+    const auto values = index.byId("value", 9, input.size());
+    assert(values.size() == 2);
+    assert(index[values[0]].match().content() == "7");
+    assert(index[values[1]].match().content() == "12");
+
+    //innermost match that contains an offset
+    assert(index[index.innermost(0)].match().id() == "record");
+    assert(index[index.innermost(5)].match().id() == "digit");
+    assert(index[index.innermost(5)].begin() == 5);
+    assert(index[index.innermost(3)].match().id() == "record");
+    assert(index.innermost(8) == index.None);
+    assert(index.innermost(input.size()) == index.None);
+
+    //children of a match
+    const size_t secondRecord = index.byId("record")[1];
+    const auto children = index.children(secondRecord);
+    assert(children.size() == 2);
+    assert(index[children[0]].match().id() == "key");
+    assert(index[children[1]].match().id() == "value");
+    assert(index[children[1]].parent() == secondRecord);
+    assert(index[children[0]].begin() == 10);
+    assert(index[children[0]].end() == 11);
+}
+
+
+static void unitTest_parseEach() {
+    const auto digit = terminalRange('0', '9');
+    const auto item = (+digit == std::string("number")) >> ';';
+
+    //items are yielded one at a time, with the matches of the item only
+    {
+        const std::string input = "1;23;456;";
+        std::vector<std::string> contents;
+        for (const auto& each : parseEach(item, input)) {
+            assert(each.success());
+            assert(each.matches().size() == 1);
+            assert(each.errors().empty());
+            contents.push_back(each.matches()[0].content());
+            assert(std::string(each.begin().iterator(), each.end().iterator()) == contents.back() + ";");
+        }
+        assert((contents == std::vector<std::string>{ "1", "23", "456" }));
+    }
+
+    //iteration stops after a failed item, which carries the errors
+    {
+        const std::string input = "1;2x;3;";
+        auto range = parseEach(item, input);
+        auto it = range.begin();
+        assert(it != range.end() && it->success() && it->matches()[0].content() == "1");
+        ++it;
+        assert(it != range.end() && !it->success());
+        assert(it->matches().empty());
+        assert(it->errors().size() == 1);
+        assert(it->errors()[0].position().iterator() == input.begin() + 3);
+        ++it;
+        assert(it == range.end());
+    }
+
+    //rules are referenced
+    {
+        Rule<> number = (+digit == std::string("number")) >> -(terminal(',') >> number);
+        Rule<> list = '[' >> number >> ']';
+        const std::string input = "[1,2][3]";
+        size_t count = 0;
+        size_t matchCount = 0;
+        for (const auto& each : parseEach(list, input)) {
+            assert(each.success());
+            ++count;
+            matchCount += each.matches().size();
+        }
+        assert(count == 2);
+        assert(matchCount == 3);
+    }
+
+    //a moved range yields the items of its own context
+    {
+        const std::string input = "1;23;";
+        auto range = parseEach(item, input);
+        auto moved = std::move(range);
+        size_t matchCount = 0;
+        for (const auto& each : moved) {
+            matchCount += each.matches().size();
+        }
+        assert(matchCount == 2);
+    }
+
+    //empty source
+    {
+        const std::string input;
+        auto range = parseEach(item, input);
+        assert(range.begin() == range.end());
+    }
+}
+
+
+static void unitTest_sharedMemo() {
+    using PC = ParseContext<>;
+    const Rule<> r = ('x' >> memo(r) >> 'a' | 'x' >> memo(r) >> 'b' | 'x') == std::string("r");
+    const std::string input = std::string(200, 'x') + std::string(199, 'b');
+
+    //results stored by one context are replayed by another
+    {
+        const auto table = std::make_shared<PC::SharedMemoTableType>();
+        PC pc1(input);
+        pc1.setSharedMemoTable(table);
+        assert(r(pc1));
+        assert(pc1.sourceEnded());
+        assert(pc1.memoTable().size() == 0);
+        assert(table->size() == 200);
+
+        PC pc2(input);
+        pc2.setSharedMemoTable(table);
+        pc2.increaseSourcePosition(100);
+        assert(r(pc2));
+        assert(pc2.sourcePosition().iterator() == input.end() - 100);
+        assert(table->size() == 200);
+
+        pc2.reset(input);
+        assert(!pc2.sharedMemoTable());
+    }
+
+    //contexts of different threads parse regions of the same source
+    {
+        const auto table = std::make_shared<PC::SharedMemoTableType>();
+        std::vector<std::thread> threads;
+        std::vector<size_t> matchCounts(4);
+        std::vector<char> results(4);
+        for (size_t index = 0; index < 4; ++index) {
+            threads.emplace_back([&, index]() {
+                PC pc(input);
+                pc.setSharedMemoTable(table);
+                pc.increaseSourcePosition(index * 50);
+                results[index] = r(pc);
+                matchCounts[index] = pc.matches().size();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (size_t index = 0; index < 4; ++index) {
+            PC pc(input);
+            pc.increaseSourcePosition(index * 50);
+            assert(static_cast<bool>(results[index]) == r(pc));
+            assert(matchCounts[index] == pc.matches().size());
+        }
+        assert(table->size() == 200);
+    }
+
+    //the number of slots is fixed; the capacity is rounded up to a power of 2, of at least the number of probed slots
+    {
+        const std::string shortInput = std::string(20, 'x') + std::string(19, 'b');
+        const auto table = std::make_shared<PC::SharedMemoTableType>(8);
+        PC pc(shortInput);
+        pc.setSharedMemoTable(table);
+        assert(r(pc));
+        assert(pc.sourceEnded());
+        assert(table->capacity() == 32);
+        assert(table->size() == 20);
+    }
+
+    //replayed results add and commit the errors of error recovery the way parsing did
+    {
+        const Rule<> items = *((('a' >> terminal('b')) >> ~terminal(';')) == std::string("item"));
+        const auto grammar = memo(items) >> eof();
+        const std::string errorInput = "ax;ay;ab;";
+
+        PC pc(errorInput);
+        assert(items(pc));
+        assert(pc.errors().size() == 2);
+
+        const auto table = std::make_shared<PC::SharedMemoTableType>();
+        PC pc1(errorInput);
+        pc1.setSharedMemoTable(table);
+        assert(grammar(pc1));
+        assert(pc1.errors().size() == 2);
+
+        PC pc2(errorInput);
+        pc2.setSharedMemoTable(table);
+        assert(grammar(pc2));
+        assert(pc2.errors().size() == 2);
+        assert(pc2.errors()[0].position() == pc1.errors()[0].position());
+        assert(pc2.errors()[1].position() == pc1.errors()[1].position());
+        assert(pc2.committedErrorCount() == pc1.committedErrorCount());
+
+        const auto replayed = (memo(items) >> 'z') | (memo(items) >> eof());
+        const auto parsed = (items >> 'z') | (items >> eof());
+        PC pc3(errorInput);
+        assert(replayed(pc3));
+        PC pc4(errorInput);
+        assert(parsed(pc4));
+        assert(pc3.errors().size() == pc4.errors().size());
+        assert(pc3.committedErrorCount() == pc4.committedErrorCount());
+    }
+}
+
+
+static void unitTest_fixedWidth() {
+    using PC = ParseContext<>;
+
+    const auto digit = terminalRange('0', '9');
+    const auto hexDigit = terminalRange('0', '9') | terminalRange('a', 'f') | terminalRange('A', 'F');
+    const auto date = (digit >> digit >> digit >> digit >> '-' >> digit >> digit >> '-' >> digit >> digit) == std::string("date");
+    const auto time = (2 * digit >> ':' >> 2 * digit >> ':' >> 2 * digit) == std::string("time");
+    const auto uuid = (8 * hexDigit >> '-' >> 4 * hexDigit >> '-' >> 4 * hexDigit >> '-' >> 4 * hexDigit >> '-' >> 12 * hexDigit) == std::string("uuid");
+    const auto record = date >> 'T' >> time >> ' ' >> uuid;
+    const auto grammar = *(record >> '\n') >> eof();
+    const auto compiled = compile(grammar);
+
+    static_assert(IsFixedWidthCharPattern<decltype(4 * hexDigit)>::value);
+    static_assert(IsFixedWidthCharPattern<std::decay_t<decltype(date.child())>>::value);
+    static_assert(!IsFixedWidthCharPattern<decltype(digit >> +digit)>::value);
+    static_assert(std::is_same_v<decltype(compile(4 * digit)), FixedWidthCharParser<LoopNParser<TerminalRangeParser<char>>>>);
+    assert(compile(date.child()).table().size() == 10);
+    assert(compile(uuid.child()).table().size() == 36);
+
+    const Skipper skipper;
+    for (const std::string input : {
+        "2024-01-31T12:34:56 123e4567-e89b-12d3-a456-426614174000\n1999-12-31T23:59:59 ABCDEF01-2345-6789-abcd-ef0123456789\n",
+        "2024-01-31T12:34:56 123e4567-e89b-12d3-a456-42661417400g\n",
+        "2024-1-31T12:34:56 123e4567-e89b-12d3-a456-426614174000\n",
+        "2024-01-31T12:34",
+        "2024-01-3",
+        "" })
+    {
+        assertSameParse<PC>(grammar, compiled, input);
+        assertSameParse<PC>(grammar, compiled, input, &skipper);
+        assertSameParse<PC>(date, compile(date), input.substr(0, 4));
+    }
+
+    //case-insensitive sources, and sources that are not contiguous
+    assertSameParse<ParseContext<std::string, std::string, SourcePosition<std::string, false>>>(3 * terminalRange('a', 'c'), compile(3 * terminalRange('a', 'c')), std::string("aBcd"));
+    assertSameParse<ParseContext<std::string, std::string, LineCountingSourcePosition<std::string>>>(terminal('x') >> '\n' >> 'y', compile(terminal('x') >> '\n' >> 'y'), std::string("x\nyz"));
+    assertSameParse<ParseContext<std::vector<int>>>(2 * terminalRange('a', 'z'), compile(2 * terminalRange('a', 'z')), std::vector<int>{ 'a', 'b', 'c' });
+    const std::vector<std::string> buffers{ "20", "24-0", "1-31" };
+    const RopeSource<> rope({ buffers[0], buffers[1], buffers[2] });
+    ParseContext<RopeSource<>> ropePc(rope);
+    assert(compile(date.child())(ropePc));
+    assert(ropePc.sourceEnded());
+}
+
+
 void runUnitTests() {
     //unitTest_AndParser();
     //unitTest_ChoiceParser();
@@ -1052,4 +2571,27 @@ void runUnitTests() {
     //unitTest_lineCountingSourcePosition();
     //unitTest_errorHandling();
     unitTest_errorRecovery();
+    unitTest_numberParsers();
+    unitTest_skipper();
+    unitTest_binaryParsers();
+    unitTest_search();
+    unitTest_batch();
+    unitTest_snapshot();
+    unitTest_matchDag();
+    unitTest_flatMatch();
+    unitTest_flatMatchStore();
+    unitTest_rope();
+    unitTest_viewSources();
+    unitTest_list();
+    unitTest_lookahead();
+    unitTest_adaptiveChoice();
+    unitTest_predictive();
+    unitTest_memo();
+    unitTest_compile();
+    unitTest_boundary();
+    unitTest_symbols();
+    unitTest_matchIndex();
+    unitTest_parseEach();
+    unitTest_sharedMemo();
+    unitTest_fixedWidth();
 }